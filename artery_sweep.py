@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""
+Run all runs of an OMNeT++ configuration by a pool of parallel worker processes.
+
+Runs are split into contiguous batches, one per worker, and each worker executes its
+batch within a single Cmdenv process. Hence, scenario data shared among runs of one
+process (see "shared-artefacts" option) such as obstacle polygons is only built once
+per worker. Each run keeps its own seed set and result files as configured in the ini file.
+
+Example:
+    artery_sweep.py -j 8 -c Mode4 -- ./run_artery.sh omnetpp.ini
+"""
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import time
+
+
+def query_run_numbers(command, config, run_filter):
+    query = command + ['-u', 'Cmdenv', '-c', config, '-q', 'runnumbers']
+    if run_filter:
+        query += ['-r', run_filter]
+    output = subprocess.run(query, stdout=subprocess.PIPE, universal_newlines=True, check=True).stdout
+    # last line solely consisting of numbers lists the matching runs
+    for line in reversed(output.splitlines()):
+        if re.fullmatch(r'\s*\d+(\s+\d+)*\s*', line):
+            return [int(run) for run in line.split()]
+    return []
+
+
+def split_batches(runs, workers):
+    batches = []
+    size, remainder = divmod(len(runs), workers)
+    start = 0
+    for worker in range(workers):
+        end = start + size + (1 if worker < remainder else 0)
+        if end > start:
+            batches.append(runs[start:end])
+        start = end
+    return batches
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('-j', '--jobs', type=int, default=os.cpu_count() or 1, help='number of parallel workers')
+    parser.add_argument('-c', '--config', default='General', help='configuration to run')
+    parser.add_argument('-r', '--runs', help='run filter as accepted by Cmdenv, e.g. "0..9"')
+    parser.add_argument('--log-dir', default='results', help='directory for worker logs')
+    parser.add_argument('command', nargs=argparse.REMAINDER, help='simulation command, e.g. ./run_artery.sh omnetpp.ini')
+    args = parser.parse_args()
+
+    command = args.command[1:] if args.command[:1] == ['--'] else args.command
+    if not command:
+        parser.error('simulation command is missing')
+    if args.jobs < 1:
+        parser.error('at least one worker is required')
+
+    runs = query_run_numbers(command, args.config, args.runs)
+    if not runs:
+        print('No runs found for configuration {}'.format(args.config), file=sys.stderr)
+        return 1
+
+    os.makedirs(args.log_dir, exist_ok=True)
+    workers = []
+    for index, batch in enumerate(split_batches(runs, args.jobs)):
+        log_name = os.path.join(args.log_dir, '{}-worker{}.log'.format(args.config, index))
+        log = open(log_name, 'w')
+        worker = command + ['-u', 'Cmdenv', '-c', args.config, '-r', ','.join(str(run) for run in batch),
+                '--cmdenv-stop-batch-on-error=false']
+        process = subprocess.Popen(worker, stdout=log, stderr=subprocess.STDOUT)
+        workers.append((process, batch, log, log_name))
+
+    print('Started {} workers for {} runs of {}'.format(len(workers), len(runs), args.config))
+    start = time.monotonic()
+    failed = 0
+    for process, batch, log, log_name in workers:
+        status = process.wait()
+        log.close()
+        if status != 0:
+            failed += 1
+            print('Worker for runs {}..{} failed with status {}, see {}'.format(batch[0], batch[-1], status, log_name),
+                    file=sys.stderr)
+
+    print('Finished {} runs in {:.1f} s'.format(len(runs), time.monotonic() - start))
+    return 1 if failed else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -2,6 +2,11 @@
 #include "lte_msgs/BlackIceWarning_m.h"
 #include <inet/networklayer/common/L3AddressResolver.h>
 #include <inet/transportlayer/contract/udp/UDPControlInfo.h>
+#include <boost/geometry/algorithms/comparable_distance.hpp>
+#include <boost/geometry/algorithms/equals.hpp>
+#include <boost/geometry/geometries/box.hpp>
+#include <algorithm>
+#include <chrono>
 
 using namespace omnetpp;
 
@@ -21,6 +26,11 @@ void BlackIceCentral::initialize()
     querySocket.setOutputGate(gate("udpOut"));
     querySocket.bind(inet::L3Address(), queryPort);
 
+    reportLifetime = par("reportLifetime");
+    measureTime = par("measureTime");
+    maxStoredReports = 0;
+    queryProcessingTime.setName("queryProcessingTime");
+
     numReceivedWarnings = 0;
     numReceivedQueries = 0;
     WATCH(numReceivedWarnings);
@@ -34,6 +44,16 @@ void BlackIceCentral::finish()
 
     recordScalar("numReceivedWarnings", numReceivedWarnings);
     recordScalar("numReceivedQueries", numReceivedQueries);
+    if (reportLifetime > SimTime::ZERO) {
+        // without expiry, all received warnings are stored
+        recordScalar("numStoredReports", reports.size());
+        recordScalar("maxStoredReports", maxStoredReports);
+    }
+    if (measureTime && queryProcessingTime.getCount() > 0) {
+        // wall-clock durations differ from run to run, thus they are not recorded by default
+        recordScalar("meanQueryProcessingTime", queryProcessingTime.getMean(), "us");
+        recordScalar("maxQueryProcessingTime", queryProcessingTime.getMax(), "us");
+    }
 }
 
 void BlackIceCentral::handleMessage(cMessage* msg)
@@ -66,19 +86,45 @@ void BlackIceCentral::processPacket(cPacket* pkt)
 void BlackIceCentral::processReport(BlackIceReport& report)
 {
     ++numReceivedWarnings;
-    reports.push_back(report);
+    expireReports();
+
+    StoredReport stored { Point { report.getPositionX(), report.getPositionY() }, simTime() };
+    reports.insert(stored);
+    if (reportLifetime > SimTime::ZERO) {
+        reportExpiry.push_back(stored);
+    }
+    maxStoredReports = std::max(maxStoredReports, reports.size());
 }
 
 void BlackIceCentral::processQuery(BlackIceQuery& query, const inet::L3Address& addr, int port)
 {
+    namespace bg = boost::geometry;
+    namespace bgi = boost::geometry::index;
+
     ++numReceivedQueries;
+    expireReports();
+
+    std::chrono::steady_clock::time_point start;
+    if (measureTime) {
+        start = std::chrono::steady_clock::now();
+    }
+    const Point center { query.getPositionX(), query.getPositionY() };
+    const double radius = query.getRadius();
+    const bg::model::box<Point> bounds {
+        Point { center.x() - radius, center.y() - radius },
+        Point { center.x() + radius, center.y() + radius }
+    };
+    auto inside = [&center, radius](const StoredReport& report) {
+        return bg::comparable_distance(report.first, center) < radius * radius;
+    };
+
     int warnings = 0;
-    for (auto& report : reports) {
-        double dx = query.getPositionX() - report.getPositionX();
-        double dy = query.getPositionY() - report.getPositionY();
-        if (dx * dx + dy * dy < query.getRadius() * query.getRadius()) {
-            ++warnings;
-        }
+    for (auto it = reports.qbegin(bgi::intersects(bounds) && bgi::satisfies(inside)); it != reports.qend(); ++it) {
+        ++warnings;
+    }
+    if (measureTime) {
+        const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+        queryProcessingTime.collect(elapsed.count());
     }
 
     auto response = new BlackIceResponse("black ice response");
@@ -86,3 +132,11 @@ void BlackIceCentral::processQuery(BlackIceQuery& query, const inet::L3Address&
     querySocket.sendTo(response, addr, port);
 }
 
+void BlackIceCentral::expireReports()
+{
+    const SimTime now = simTime();
+    while (!reportExpiry.empty() && reportExpiry.front().second + reportLifetime <= now) {
+        reports.remove(reportExpiry.front());
+        reportExpiry.pop_front();
+    }
+}
@@ -1,10 +1,14 @@
 #ifndef BLACKICECENTRAL_H_3LKZ0NOB
 #define BLACKICECENTRAL_H_3LKZ0NOB
 
+#include <boost/geometry/geometries/point_xy.hpp>
+#include <boost/geometry/index/rtree.hpp>
 #include <inet/networklayer/common/L3Address.h>
 #include <inet/transportlayer/contract/udp/UDPSocket.h>
 #include <omnetpp/csimplemodule.h>
-#include <list>
+#include <omnetpp/cstddev.h>
+#include <deque>
+#include <utility>
 
 // forward declaration
 class BlackIceQuery;
@@ -21,10 +25,15 @@ protected:
     void handleMessage(omnetpp::cMessage*) override;
 
 private:
+    using Point = boost::geometry::model::d2::point_xy<double>;
+    using StoredReport = std::pair<Point, omnetpp::SimTime>; /*< position and reception time */
+    using ReportIndex = boost::geometry::index::rtree<StoredReport, boost::geometry::index::rstar<16>>;
+
     void processPacket(omnetpp::cPacket*);
     void processReport(BlackIceReport&);
     void processQuery(BlackIceQuery&, const inet::L3Address&, int port);
     void disseminateWarning();
+    void expireReports();
 
     int reportPort;
     int queryPort;
@@ -32,7 +41,12 @@ private:
     int numReceivedQueries;
     inet::UDPSocket reportSocket;
     inet::UDPSocket querySocket;
-    std::list<BlackIceReport> reports;
+    omnetpp::SimTime reportLifetime;
+    ReportIndex reports;
+    std::deque<StoredReport> reportExpiry; /*< reports in order of reception */
+    std::size_t maxStoredReports;
+    omnetpp::cStdDev queryProcessingTime;
+    bool measureTime;
 };
 
 #endif /* BLACKICECENTRAL_H_3LKZ0NOB */
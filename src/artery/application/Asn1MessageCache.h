@@ -0,0 +1,149 @@
+/*
+* Artery V2X Simulation Framework
+* Licensed under GPLv2, see COPYING file for detailed license and warranty terms.
+*/
+
+#ifndef ARTERY_ASN1MESSAGECACHE_H_LQ4ZVN7E
+#define ARTERY_ASN1MESSAGECACHE_H_LQ4ZVN7E
+
+#include <boost/functional/hash.hpp>
+#include <vanetza/common/byte_buffer.hpp>
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+
+namespace artery
+{
+
+/**
+ * Asn1MessageCache memoizes decoding and constraint validation of ASN.1 messages.
+ *
+ * A message received by many stations is either the very same wrapper object (ChunkPacket)
+ * or the same encoding (CohesivePacket). Hence, decoding and validation results are shared
+ * as long as any receiver holds the decoded message. Entries do not extend message lifetime.
+ */
+template<class T>
+class Asn1MessageCache
+{
+public:
+    static Asn1MessageCache& instance()
+    {
+        static Asn1MessageCache cache;
+        return cache;
+    }
+
+    /**
+     * Get decoded message for given encoding
+     *
+     * \param buffer encoded message
+     * \param decoded set to true if message was not cached and has been decoded
+     * \return decoded message or nullptr if decoding failed
+     */
+    std::shared_ptr<const T> decode(vanetza::ByteBuffer&& buffer, bool& decoded)
+    {
+        decoded = false;
+        auto found = mDecoded.find(buffer);
+        if (found != mDecoded.end()) {
+            if (auto wrapper = found->second.lock()) {
+                return wrapper;
+            }
+        }
+
+        auto wrapper = std::make_shared<T>();
+        decoded = true;
+        if (!wrapper->decode(buffer)) {
+            return nullptr;
+        }
+
+        if (found != mDecoded.end()) {
+            found->second = wrapper;
+        } else {
+            purge(mDecoded);
+            mDecoded.emplace(std::move(buffer), wrapper);
+        }
+        return wrapper;
+    }
+
+    /**
+     * Check message's constraints once per message object
+     *
+     * \param wrapper message to be validated
+     * \param validated set to true if validation result was not cached and has been computed
+     * \return true if message satisfies its constraints
+     */
+    bool validate(const std::shared_ptr<const T>& wrapper, bool& validated)
+    {
+        validated = false;
+        // an unexpired entry guarantees that it refers to the object still living at this address
+        auto found = mValidity.find(wrapper.get());
+        if (found != mValidity.end() && !found->second.object.expired()) {
+            return found->second.valid;
+        }
+
+        const bool valid = wrapper->validate();
+        validated = true;
+        if (found != mValidity.end()) {
+            found->second = Validity { wrapper, valid };
+        } else {
+            purge(mValidity);
+            mValidity.emplace(wrapper.get(), Validity { wrapper, valid });
+        }
+        return valid;
+    }
+
+private:
+    struct Validity
+    {
+        std::weak_ptr<const T> object;
+        bool valid;
+    };
+
+    struct BufferHash
+    {
+        std::size_t operator()(const vanetza::ByteBuffer& buffer) const
+        {
+            return boost::hash_range(buffer.begin(), buffer.end());
+        }
+    };
+
+    static const std::weak_ptr<const T>& object(const std::weak_ptr<const T>& ptr) { return ptr; }
+    static const std::weak_ptr<const T>& object(const Validity& validity) { return validity.object; }
+
+    /**
+     * Sweep entries of expired messages once map size has doubled since last sweep
+     */
+    template<typename MAP>
+    void purge(MAP& map)
+    {
+        std::size_t& threshold = purgeThreshold(map);
+        if (map.size() >= threshold) {
+            for (auto it = map.begin(); it != map.end();) {
+                if (object(it->second).expired()) {
+                    it = map.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+            threshold = std::max<std::size_t>(scMinPurgeThreshold, 2 * map.size());
+        }
+    }
+
+    using DecodedMap = std::unordered_map<vanetza::ByteBuffer, std::weak_ptr<const T>, BufferHash>;
+    using ValidityMap = std::unordered_map<const T*, Validity>;
+
+    std::size_t& purgeThreshold(DecodedMap&) { return mDecodedPurgeThreshold; }
+    std::size_t& purgeThreshold(ValidityMap&) { return mValidityPurgeThreshold; }
+
+    static constexpr std::size_t scMinPurgeThreshold = 1024;
+    DecodedMap mDecoded;
+    ValidityMap mValidity;
+    std::size_t mDecodedPurgeThreshold = scMinPurgeThreshold;
+    std::size_t mValidityPurgeThreshold = scMinPurgeThreshold;
+};
+
+template<class T>
+constexpr std::size_t Asn1MessageCache<T>::scMinPurgeThreshold;
+
+} // namespace artery
+
+#endif /* ARTERY_ASN1MESSAGECACHE_H_LQ4ZVN7E */
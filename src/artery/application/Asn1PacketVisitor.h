@@ -16,6 +16,7 @@
 #ifndef __ARTERY_ASN1PACKETVISITOR_H_
 #define __ARTERY_ASN1PACKETVISITOR_H_
 
+#include "artery/application/Asn1MessageCache.h"
 #include <vanetza/common/byte_buffer.hpp>
 #include <vanetza/common/byte_buffer_convertible.hpp>
 #include <vanetza/net/chunk_packet.hpp>
@@ -32,37 +33,36 @@ namespace artery
 template<class T>
 struct Asn1PacketVisitor : public boost::static_visitor<const T*>
 {
-    const T* operator()(vanetza::CohesivePacket& packet)
+    const T* operator()(const vanetza::CohesivePacket& packet)
     {
         const auto range = packet[vanetza::OsiLayer::Application];
         vanetza::ByteBuffer buffer { range.begin(), range.end() };
-        deserialize(buffer);
+        deserialize(std::move(buffer));
         return shared_wrapper.get();
     }
 
-    const T* operator()(vanetza::ChunkPacket& packet)
+    const T* operator()(const vanetza::ChunkPacket& packet)
     {
         typedef vanetza::convertible::byte_buffer byte_buffer;
         typedef vanetza::convertible::byte_buffer_impl<T> byte_buffer_impl;
 
-        byte_buffer* ptr = packet[vanetza::OsiLayer::Application].ptr();
-        auto impl = dynamic_cast<byte_buffer_impl*>(ptr);
+        const byte_buffer* ptr = packet[vanetza::OsiLayer::Application].ptr();
+        auto impl = dynamic_cast<const byte_buffer_impl*>(ptr);
         if (impl) {
             shared_wrapper = impl->wrapper();
             return shared_wrapper.get();
         } else {
             vanetza::ByteBuffer buffer;
             packet[vanetza::OsiLayer::Application].convert(buffer);
-            deserialize(buffer);
+            deserialize(std::move(buffer));
             return shared_wrapper.get();
         }
     }
 
-    void deserialize(const vanetza::ByteBuffer& buffer)
+    void deserialize(vanetza::ByteBuffer&& buffer)
     {
-        auto temp_wrapper = std::make_shared<T>();
-        bool decoded = temp_wrapper->decode(buffer);
-        if (decoded) {
+        auto temp_wrapper = Asn1MessageCache<T>::instance().decode(std::move(buffer), decoded);
+        if (temp_wrapper) {
             shared_wrapper = temp_wrapper;
         } else {
             using namespace omnetpp;
@@ -71,7 +71,17 @@ struct Asn1PacketVisitor : public boost::static_visitor<const T*>
         }
     }
 
+    /**
+     * Check constraints of visited message, only once for all receivers of this message
+     */
+    bool validate()
+    {
+        return shared_wrapper && Asn1MessageCache<T>::instance().validate(shared_wrapper, validated);
+    }
+
     std::shared_ptr<const T> shared_wrapper;
+    bool decoded = false; /*< message has been decoded by this visitor */
+    bool validated = false; /*< constraints have been checked by this visitor */
 };
 
 } // namespace artery
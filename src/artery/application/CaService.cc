@@ -110,13 +110,24 @@ void CaService::trigger()
     checkTriggeringConditions(simTime());
 }
 
-void CaService::indicate(const vanetza::btp::DataIndication& ind, std::unique_ptr<vanetza::UpPacket> packet)
+void CaService::finish()
+{
+    // decoding and validation are shared by all receivers, count only work done by this service
+    recordScalar("camDecodes", mDecodes);
+    recordScalar("camValidations", mValidations);
+    ItsG5BaseService::finish();
+}
+
+void CaService::indicate(const vanetza::btp::DataIndication& ind, std::shared_ptr<const vanetza::UpPacket> packet)
 {
     Enter_Method("indicate");
 
     Asn1PacketVisitor<vanetza::asn1::Cam> visitor;
     const vanetza::asn1::Cam* cam = boost::apply_visitor(visitor, *packet);
-    if (cam && cam->validate()) {
+    const bool valid = cam && visitor.validate();
+    mDecodes += visitor.decoded;
+    mValidations += visitor.validated;
+    if (valid) {
         CaObject obj = visitor.shared_wrapper;
         emit(scSignalCamReceived, &obj);
 
@@ -224,7 +235,7 @@ void CaService::sendCam(const SimTime& T_now)
 SimTime CaService::genCamDcc()
 {
     // network interface may not be ready yet during initialization, so look it up at this later point
-    auto netifc = mNetworkInterfaceTable->select(mPrimaryChannel);
+    NetworkInterface* netifc = mNetworkInterfaceTable->lookup(mPrimaryChannel);
     vanetza::dcc::TransmitRateThrottle* trc = netifc ? netifc->getDccEntity().getTransmitRateThrottle() : nullptr;
     if (!trc) {
         throw cRuntimeError("No DCC TRC found for CA's primary channel %i", mPrimaryChannel);
@@ -28,7 +28,9 @@ class CaService : public ItsG5BaseService
 	public:
 		CaService();
 		void initialize() override;
-		void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
+		void finish() override;
+		void indicate(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>) override;
+		bool acceptsSharedIndication() const override { return true; }
 		void trigger() override;
 
 	private:
@@ -63,6 +65,8 @@ class CaService : public ItsG5BaseService
 		bool mAecomSize;
 		std::vector<int> mSizes;
 		std::vector<double> mProb;
+		unsigned long mDecodes = 0;
+		unsigned long mValidations = 0;
 };
 
 vanetza::asn1::Cam createCooperativeAwarenessMessage(const VehicleDataProvider&, uint16_t genDeltaTime);
@@ -29,7 +29,7 @@ static const simsignal_t denmSentSignal = cComponent::registerSignal("DenmSent")
 static const simsignal_t storyboardSignal = cComponent::registerSignal("StoryboardSignal");
 
 DenService::DenService() :
-    mTimer(nullptr), mSequenceNumber(0)
+    mTimer(nullptr), mVehicleDataProvider(nullptr), mSequenceNumber(0)
 {
 }
 
@@ -37,6 +37,7 @@ void DenService::initialize()
 {
     ItsG5BaseService::initialize();
     mTimer = &getFacilities().get_const<Timer>();
+    mVehicleDataProvider = &getFacilities().get_const<VehicleDataProvider>();
     mMemory.reset(new artery::den::Memory(*mTimer));
 
     subscribe(storyboardSignal);
@@ -80,11 +81,18 @@ void DenService::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cO
     }
 }
 
-void DenService::indicate(const vanetza::btp::DataIndication& indication, std::unique_ptr<vanetza::UpPacket> packet)
+void DenService::finish()
+{
+    recordScalar("denmDecodes", mDecodes);
+    ItsG5BaseService::finish();
+}
+
+void DenService::indicate(const vanetza::btp::DataIndication& indication, std::shared_ptr<const vanetza::UpPacket> packet)
 {
     Asn1PacketVisitor<vanetza::asn1::Denm> visitor;
     const vanetza::asn1::Denm* denm = boost::apply_visitor(visitor, *packet);
-    const auto egoStationID = getFacilities().get_const<VehicleDataProvider>().station_id();
+    mDecodes += visitor.decoded;
+    const auto egoStationID = mVehicleDataProvider->station_id();
 
     if (denm && (*denm)->header.stationID != egoStationID) {
         DenmObject obj = visitor.shared_wrapper;
@@ -109,7 +117,7 @@ void DenService::trigger()
 ActionID_t DenService::requestActionID()
 {
     ActionID_t id;
-    id.originatingStationID = getFacilities().get_const<VehicleDataProvider>().station_id();
+    id.originatingStationID = mVehicleDataProvider->station_id();
     id.sequenceNumber = ++mSequenceNumber;
     return id;
 }
@@ -21,14 +21,17 @@ namespace artery
 {
 
 class Timer;
+class VehicleDataProvider;
 
 class DenService : public ItsG5BaseService
 {
     public:
         DenService();
         void initialize() override;
+        void finish() override;
         void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
-        void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
+        void indicate(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>) override;
+        bool acceptsSharedIndication() const override { return true; }
         void trigger() override;
 
         using ItsG5BaseService::getFacilities;
@@ -43,9 +46,11 @@ class DenService : public ItsG5BaseService
         void initUseCases();
 
         const Timer* mTimer;
+        const VehicleDataProvider* mVehicleDataProvider;
         uint16_t mSequenceNumber;
         std::shared_ptr<artery::den::Memory> mMemory;
         std::list<artery::den::UseCase*> mUseCases;
+        unsigned long mDecodes = 0;
 };
 
 } // namespace artery
@@ -44,7 +44,7 @@ void ExampleService::indicate(const btp::DataIndication& ind, cPacket* packet, c
 	Enter_Method("indicate");
 
 	if (packet->getByteLength() == 42) {
-		EV_INFO << "packet indication on channel " << net.channel << "\n";
+		EV_INFO << "packet indication on channel " << net.getChannel() << "\n";
 	}
 
 	delete(packet);
@@ -0,0 +1,19 @@
+#include "artery/application/Facilities.h"
+#include <mutex>
+#include <unordered_map>
+
+namespace artery
+{
+namespace detail
+{
+
+std::size_t allocate_facility_slot(const std::type_index& type)
+{
+	static std::mutex mutex;
+	static std::unordered_map<std::type_index, std::size_t> slots;
+	std::lock_guard<std::mutex> lock(mutex);
+	return slots.emplace(type, slots.size()).first->second;
+}
+
+} // namespace detail
+} // namespace artery
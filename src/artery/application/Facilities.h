@@ -20,17 +20,48 @@
 #define ARTERY_FACILITIES_H_
 
 #include <cassert>
+#include <cstddef>
 #include <stdexcept>
 #include <typeindex>
 #include <typeinfo>
-#include <unordered_map>
+#include <vector>
 #include <omnetpp/cexception.h>
 
 namespace artery
 {
 
+namespace detail
+{
+
+/**
+ * Get slot index of a facility type shared by all Facilities instances
+ *
+ * Slots are allocated by core library only, i.e. libraries built with hidden
+ * visibility (and thus private copies of facility_slot) still agree on them.
+ * \param type facility type
+ * \return slot index, identical for all calls with the same type
+ */
+std::size_t allocate_facility_slot(const std::type_index& type);
+
+/**
+ * Each facility type looks up its slot once when it is used first.
+ */
+template<typename T>
+struct facility_slot
+{
+	static std::size_t index()
+	{
+		static const std::size_t slot = allocate_facility_slot(typeid(T));
+		return slot;
+	}
+};
+
+} // namespace detail
+
 /**
  * Context class for each ITS-G5 service provided by middleware
+ *
+ * Objects are stored in slots indexed by their type, i.e. a look-up is a single indexed load.
  */
 class Facilities
 {
@@ -40,12 +71,8 @@ class Facilities
 		{
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			DT* object = nullptr;
-			auto found = m_mutable_objects.find(std::type_index(typeid(DT)));
-			if (found != m_mutable_objects.end()) {
-				object = static_cast<DT*>(found->second);
-			}
-			return object;
+			const std::size_t slot = detail::facility_slot<DT>::index();
+			return slot < m_mutable_objects.size() ? static_cast<DT*>(m_mutable_objects[slot]) : nullptr;
 		}
 
 		template<typename T>
@@ -73,12 +100,8 @@ class Facilities
 		{
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			const DT* object = nullptr;
-			auto found = m_const_objects.find(std::type_index(typeid(DT)));
-			if (found != m_const_objects.end()) {
-				object = static_cast<const DT*>(found->second);
-			}
-			return object;
+			const std::size_t slot = detail::facility_slot<DT>::index();
+			return slot < m_const_objects.size() ? static_cast<const DT*>(m_const_objects[slot]) : nullptr;
 		}
 
 		template<typename T>
@@ -107,7 +130,7 @@ class Facilities
 			assert(object);
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			m_mutable_objects[std::type_index(typeid(DT))] = object;
+			store(m_mutable_objects, detail::facility_slot<DT>::index(), object);
 			register_const(object);
 		}
 
@@ -123,7 +146,7 @@ class Facilities
 			assert(object);
 			static_assert(std::is_class<T>::value, "T has to be a class type");
 			using DT = typename std::decay<T>::type;
-			m_const_objects[std::type_index(typeid(DT))] = object;
+			store(m_const_objects, detail::facility_slot<DT>::index(), object);
 		}
 
 		template<typename T>
@@ -133,8 +156,17 @@ class Facilities
 		}
 
 	private:
-		std::unordered_map<std::type_index, void*> m_mutable_objects;
-		std::unordered_map<std::type_index, const void*> m_const_objects;
+		template<typename P>
+		static void store(std::vector<P>& slots, std::size_t slot, typename std::vector<P>::value_type object)
+		{
+			if (slot >= slots.size()) {
+				slots.resize(slot + 1, nullptr);
+			}
+			slots[slot] = object;
+		}
+
+		std::vector<void*> m_mutable_objects;
+		std::vector<const void*> m_const_objects;
 };
 
 } // namespace artery
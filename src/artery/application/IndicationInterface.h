@@ -2,6 +2,7 @@
 #define ARTERY_INDICATIONINTERFACE_H_
 
 #include <vanetza/btp/data_indication.hpp>
+#include <memory>
 
 namespace artery
 {
@@ -16,6 +17,18 @@ class IndicationInterface
     public:
         virtual void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>, const NetworkInterface&) = 0;
 
+        /**
+         * Indicate a packet which is shared with other listeners of the same transport descriptor.
+         * Only called if acceptsSharedIndication() returns true.
+         */
+        virtual void indicate(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>, const NetworkInterface&) {}
+
+        /**
+         * Listeners only reading the indicated packet can share it with others, i.e. no copy is made for them.
+         * Listeners requiring exclusive ownership, e.g. for consuming a packet's payload, must return false.
+         */
+        virtual bool acceptsSharedIndication() const { return false; }
+
         virtual ~IndicationInterface() = default;
 };
 
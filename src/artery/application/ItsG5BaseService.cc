@@ -28,7 +28,7 @@ namespace artery
 {
 
 ItsG5BaseService::ItsG5BaseService() :
-	m_middleware(nullptr)
+	m_middleware(nullptr), m_facilities(nullptr)
 {
 }
 
@@ -36,18 +36,6 @@ ItsG5BaseService::~ItsG5BaseService()
 {
 }
 
-Facilities& ItsG5BaseService::getFacilities()
-{
-	assert(m_middleware);
-	return m_middleware->getFacilities();
-}
-
-const Facilities& ItsG5BaseService::getFacilities() const
-{
-	ASSERT(m_middleware);
-	return m_middleware->getFacilities();
-}
-
 bool ItsG5BaseService::requiresListener() const
 {
 	return true;
@@ -88,6 +76,7 @@ void ItsG5BaseService::initialize()
 	}
 
 	m_middleware = middleware;
+	m_facilities = &middleware->getFacilities();
 }
 
 void ItsG5BaseService::finish()
@@ -123,9 +112,20 @@ void ItsG5BaseService::request(const vanetza::btp::DataRequestB& req,
 }
 
 void ItsG5BaseService::indicate(const vanetza::btp::DataIndication& ind,
-	std::unique_ptr<vanetza::UpPacket> packet, const NetworkInterface&)
+	std::unique_ptr<vanetza::UpPacket> packet, const NetworkInterface& net)
+{
+	if (acceptsSharedIndication()) {
+		// services reading shared packets do not care about exclusive ownership
+		this->indicate(ind, std::shared_ptr<const vanetza::UpPacket> { std::move(packet) }, net);
+	} else {
+		// forward indication to "old" indicate method by default
+		this->indicate(ind, std::move(packet));
+	}
+}
+
+void ItsG5BaseService::indicate(const vanetza::btp::DataIndication& ind,
+	std::shared_ptr<const vanetza::UpPacket> packet, const NetworkInterface&)
 {
-	// forward indication to "old" indicate method by default
 	this->indicate(ind, std::move(packet));
 }
 
@@ -134,4 +134,9 @@ void ItsG5BaseService::indicate(const vanetza::btp::DataIndication& ind, std::un
 	// no-op by default
 }
 
+void ItsG5BaseService::indicate(const vanetza::btp::DataIndication& ind, std::shared_ptr<const vanetza::UpPacket> packet)
+{
+	// no-op by default
+}
+
 } // namespace artery
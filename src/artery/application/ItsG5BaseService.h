@@ -80,9 +80,11 @@ class ItsG5BaseService :
 		void finish() override;
 		void request(const vanetza::btp::DataRequestB&, std::unique_ptr<vanetza::DownPacket>, const NetworkInterface* = nullptr);
 		void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>, const NetworkInterface&) override;
+		void indicate(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>, const NetworkInterface&) override;
 		virtual void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>);
-		Facilities& getFacilities();
-		const Facilities& getFacilities() const;
+		virtual void indicate(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>);
+		Facilities& getFacilities() { assert(m_facilities); return *m_facilities; }
+		const Facilities& getFacilities() const { assert(m_facilities); return *m_facilities; }
 		PortNumber getPortNumber(ChannelNumber = channel::CCH) const;
 		std::set<TransportDescriptor> getListeningDescriptors() const;
 		omnetpp::cModule* findHost();
@@ -91,6 +93,7 @@ class ItsG5BaseService :
 
 	private:
 		Middleware* m_middleware;
+		Facilities* m_facilities; /*< cached facilities of middleware */
 		std::set<TransportDescriptor> m_listeners;
 };
 
@@ -172,6 +172,17 @@ void Middleware::initializeServices(int stage)
 void Middleware::finish()
 {
     emit(artery::IdentityRegistry::removeSignal, &mIdentity);
+
+    const auto& dispatch = mTransportDispatcher.getStatistics();
+    const double duration = simTime().dbl();
+    recordScalar("indicationCopies", dispatch.copies);
+    recordScalar("indicationCopiedBytes", dispatch.copiedBytes);
+    recordScalar("indicationShared", dispatch.sharedIndications);
+    recordScalar("transmissionCopies", mTransmissionCopies);
+    recordScalar("transmissionCopiedBytes", mTransmissionCopiedBytes);
+    if (duration > 0.0) {
+        recordScalar("copiedBytesPerSecond", (dispatch.copiedBytes + mTransmissionCopiedBytes) / duration, "B/s");
+    }
 }
 
 void Middleware::handleMessage(cMessage *msg)
@@ -228,18 +239,20 @@ void Middleware::requestTransmission(const vanetza::btp::DataRequestB& request,
 {
     Enter_Method("requestTransmission");
 
-    auto channels = mMultiChannelPolicy->allChannels(request.gn.its_aid);
+    const auto channels = mMultiChannelPolicy->channels(request.gn.its_aid);
     if (channels.empty()) {
         EV_WARN << "No channel found for ITS-AID " << request.gn.its_aid << "\n";
     }
 
     unsigned pass = 0;
     for (ChannelNumber channel : channels) {
-        auto netifc = mNetworkInterfaceTable.select(channel);
+        NetworkInterface* netifc = mNetworkInterfaceTable.lookup(channel);
         if (netifc) {
             ++pass;
-            if (channels.size() > pass) {
+            if (static_cast<unsigned>(channels.size()) > pass) {
                 // duplicate packet for all but last network interface
+                ++mTransmissionCopies;
+                mTransmissionCopiedBytes += packet->size();
                 netifc->getRouter().request(request, vanetza::duplicate(*packet));
             } else {
                 // last network interface -> pass "original" packet
@@ -47,6 +47,13 @@ class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
         const StationType& getStationType() const { return mStationType; }
         const TransportDispatcher& getTransportDispatcher() const { return mTransportDispatcher; }
 
+        /**
+         * Get services attached to this middleware
+         *
+         * Services of compound service modules are represented by their ItsG5BaseService submodule.
+         */
+        const std::set<ItsG5BaseService*>& getServices() const { return mServices; }
+
         /**
          * Register a network interface at middleware's network interface table.
          * Only previously registered interfaces are recognised by services.
@@ -87,6 +94,8 @@ class Middleware : public omnetpp::cSimpleModule, public omnetpp::cListener
         TransportDispatcher mTransportDispatcher;
         std::unique_ptr<MultiChannelPolicy> mMultiChannelPolicy;
         std::set<ItsG5BaseService*> mServices;
+        unsigned long mTransmissionCopies = 0;
+        unsigned long mTransmissionCopiedBytes = 0;
 };
 
 } // namespace artery
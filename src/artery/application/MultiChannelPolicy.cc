@@ -11,4 +11,15 @@ ChannelNumber MultiChannelPolicy::primaryChannel(vanetza::ItsAid aid) const
     return !channels.empty() ? channels.front() : 0;
 }
 
+MultiChannelPolicy::ChannelRange MultiChannelPolicy::channels(vanetza::ItsAid aid) const
+{
+    auto found = mMemoizedChannels.find(aid);
+    if (found == mMemoizedChannels.end()) {
+        found = mMemoizedChannels.emplace(aid, allChannels(aid)).first;
+    }
+
+    const std::vector<ChannelNumber>& channels = found->second;
+    return ChannelRange { channels.data(), channels.data() + channels.size() };
+}
+
 } // namespace artery
@@ -2,7 +2,9 @@
 #define ARTERY_MULTICHANNELPOLICY_H_JO180PV9
 
 #include "artery/utility/Channel.h"
+#include <boost/range/iterator_range.hpp>
 #include <vanetza/common/its_aid.hpp>
+#include <unordered_map>
 #include <vector>
 
 namespace artery
@@ -14,6 +16,8 @@ namespace artery
 class MultiChannelPolicy
 {
     public:
+        using ChannelRange = boost::iterator_range<const ChannelNumber*>;
+
         /**
          * Get all channels to which messages of ITS-AID are to be sent.
          *
@@ -32,7 +36,20 @@ class MultiChannelPolicy
          */
         virtual ChannelNumber primaryChannel(vanetza::ItsAid aid) const;
 
+        /**
+         * Get all channels of ITS-AID without copying them.
+         * This is the same channel list as given by allChannels but intended for per-packet dispatching.
+         * By default, results of allChannels are memoized per ITS-AID.
+         *
+         * \param aid ITS-AID
+         * \return range of channel numbers valid as long as this policy exists
+         */
+        virtual ChannelRange channels(vanetza::ItsAid aid) const;
+
         virtual ~MultiChannelPolicy() = default;
+
+    private:
+        mutable std::unordered_map<vanetza::ItsAid, std::vector<ChannelNumber>> mMemoizedChannels;
 };
 
 } // namespace artery
@@ -4,9 +4,19 @@
 namespace artery
 {
 
+unsigned long NetworkInterface::sChannelGeneration = 0;
+
 NetworkInterface::NetworkInterface(Router& router, IDccEntity& dcc, const TransportDispatcher& dispatcher) :
-    channel(0), mRouter(router), mDccEntity(dcc), mTransportHandler(dispatcher, *this)
+    mChannel(0), mRouter(router), mDccEntity(dcc), mTransportHandler(dispatcher, *this)
+{
+}
+
+void NetworkInterface::setChannel(ChannelNumber channel)
 {
+    if (channel != mChannel) {
+        mChannel = channel;
+        ++sChannelGeneration;
+    }
 }
 
 NetworkInterface::TransportHandler::TransportHandler(const TransportDispatcher& dispatcher, const NetworkInterface& net) :
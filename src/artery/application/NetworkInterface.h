@@ -41,9 +41,21 @@ class NetworkInterface
         Router& getRouter() const { return mRouter; }
         IDccEntity& getDccEntity() const { return mDccEntity; }
 
-        ChannelNumber channel; /*< ITS channel served by this network interface (might change during lifetime) */
+        /**
+         * ITS channel served by this network interface (might change during lifetime)
+         */
+        ChannelNumber getChannel() const { return mChannel; }
+        void setChannel(ChannelNumber);
+
+        /**
+         * Generation of channel assignments, changes whenever any network interface changes its channel
+         */
+        static unsigned long getChannelGeneration() { return sChannelGeneration; }
 
     private:
+        static unsigned long sChannelGeneration;
+
+        ChannelNumber mChannel;
         Router& mRouter;
         IDccEntity& mDccEntity;
         TransportHandler mTransportHandler;
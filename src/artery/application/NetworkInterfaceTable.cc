@@ -1,19 +1,63 @@
 #include "artery/application/NetworkInterfaceTable.h"
+#include <algorithm>
 
 namespace artery
 {
 
+namespace
+{
+// interfaces on channel numbers beyond this limit are looked up by linear search
+const ChannelNumber sMaxIndexedChannel = 1024;
+}
+
 std::shared_ptr<NetworkInterface> NetworkInterfaceTable::select(ChannelNumber ch) const
 {
-    std::shared_ptr<NetworkInterface> network;
-    for (const auto interface : mInterfaces) {
-        if (interface->channel == ch) {
-            network = interface;
-            break;
+    auto found = find(ch);
+    return found ? *found : nullptr;
+}
+
+NetworkInterface* NetworkInterfaceTable::lookup(ChannelNumber ch) const
+{
+    auto found = find(ch);
+    return found ? found->get() : nullptr;
+}
+
+const std::shared_ptr<NetworkInterface>* NetworkInterfaceTable::find(ChannelNumber ch) const
+{
+    // interfaces change their channel without notifying the table, but each change bumps the channel generation
+    if (mIndexDirty || mIndexGeneration != NetworkInterface::getChannelGeneration()) {
+        rebuildIndex();
+    }
+
+    if (ch < mChannelIndex.size()) {
+        return mChannelIndex[ch];
+    } else if (ch >= sMaxIndexedChannel) {
+        for (InterfacePointer ifc : mOrder) {
+            if ((*ifc)->getChannel() == ch) {
+                return ifc;
+            }
         }
     }
 
-    return network;
+    return nullptr;
+}
+
+void NetworkInterfaceTable::rebuildIndex() const
+{
+    std::fill(mChannelIndex.begin(), mChannelIndex.end(), nullptr);
+    for (InterfacePointer ifc : mOrder) {
+        const ChannelNumber ch = (*ifc)->getChannel();
+        if (ch < sMaxIndexedChannel) {
+            if (ch >= mChannelIndex.size()) {
+                mChannelIndex.resize(ch + 1, nullptr);
+            }
+            if (!mChannelIndex[ch]) {
+                mChannelIndex[ch] = ifc;
+            }
+        }
+    }
+    mIndexDirty = false;
+    mIndexGeneration = NetworkInterface::getChannelGeneration();
 }
 
 const NetworkInterfaceTable::TableContainer& NetworkInterfaceTable::all() const
@@ -23,7 +67,11 @@ const NetworkInterfaceTable::TableContainer& NetworkInterfaceTable::all() const
 
 void NetworkInterfaceTable::insert(std::shared_ptr<NetworkInterface> ifc)
 {
-    mInterfaces.insert(ifc);
+    auto inserted = mInterfaces.insert(ifc);
+    if (inserted.second) {
+        mOrder.push_back(&*inserted.first);
+        mIndexDirty = true;
+    }
 }
 
 } // namespace artery
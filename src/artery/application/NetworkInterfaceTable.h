@@ -5,6 +5,7 @@
 #include "artery/utility/Channel.h"
 #include <memory>
 #include <unordered_set>
+#include <vector>
 
 namespace artery
 {
@@ -18,13 +19,24 @@ class NetworkInterfaceTable
         using TableContainer = std::unordered_set<std::shared_ptr<NetworkInterface>>;
 
         /**
-         * Select the first NetworkInterfaces operating on a particular channel.
+         * Select the first inserted NetworkInterface operating on a particular channel.
          *
          * \param ch NetworkInterface shall operate on this channel
          * \return shared pointer to found NetworkInterface (might be empty)
          */
         std::shared_ptr<NetworkInterface> select(ChannelNumber ch) const;
 
+        /**
+         * Look up the NetworkInterface operating on a particular channel.
+         *
+         * Unlike select(), this method returns a non-owning pointer and is
+         * intended for per-packet dispatching.
+         *
+         * \param ch NetworkInterface shall operate on this channel
+         * \return pointer to found NetworkInterface (might be nullptr)
+         */
+        NetworkInterface* lookup(ChannelNumber ch) const;
+
         /**
          * Get all managed NetworkInterfaces.
          */
@@ -38,7 +50,19 @@ class NetworkInterfaceTable
         void insert(std::shared_ptr<NetworkInterface> ifc);
 
     private:
+        using InterfacePointer = const std::shared_ptr<NetworkInterface>*; /*< points into mInterfaces */
+        using ChannelIndex = std::vector<InterfacePointer>;
+
+        const std::shared_ptr<NetworkInterface>* find(ChannelNumber ch) const;
+        void rebuildIndex() const;
+
         TableContainer mInterfaces;
+        // interfaces in insertion order, first inserted interface wins if several share a channel
+        std::vector<InterfacePointer> mOrder;
+        // channel-indexed pointers into mInterfaces, rebuilt after insertions and channel changes
+        mutable ChannelIndex mChannelIndex;
+        mutable bool mIndexDirty = false;
+        mutable unsigned long mIndexGeneration = 0; /*< channel generation the index has been built for */
 };
 
 } // namespace artery
@@ -0,0 +1,226 @@
+#include "artery/application/PrrAnalyzer.h"
+#include "artery/application/CaObject.h"
+#include "artery/application/ItsG5BaseService.h"
+#include "artery/application/Middleware.h"
+#include "artery/networking/PositionProvider.h"
+#include "artery/utility/IdentityRegistry.h"
+#include <omnetpp/cproperties.h>
+#include <omnetpp/cproperty.h>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace artery
+{
+
+using namespace omnetpp;
+
+static const simsignal_t scSignalCamReceived = cComponent::registerSignal("CamReceived");
+static const simsignal_t scSignalCamSent = cComponent::registerSignal("CamSent");
+
+Define_Module(PrrAnalyzer)
+
+namespace
+{
+
+std::uint64_t transmissionKey(const vanetza::asn1::Cam& cam)
+{
+    return static_cast<std::uint64_t>(cam->header.stationID) << 16 | cam->cam.generationDeltaTime;
+}
+
+std::vector<int> findCaServices(const Middleware& middleware)
+{
+    std::vector<int> services;
+    for (const ItsG5BaseService* service : middleware.getServices()) {
+        if (service->getProperties()->get("signal", "CamReceived")) {
+            services.push_back(service->getId());
+        }
+    }
+    return services;
+}
+
+} // namespace
+
+void PrrAnalyzer::initialize()
+{
+    mWindow = par("receptionWindow");
+    mBinSize = par("binSize");
+    mMaxDistance = par("maxDistance");
+    if (mBinSize <= 0.0) {
+        throw cRuntimeError("binSize has to be positive");
+    } else if (mWindow >= SimTime(65, SIMTIME_S)) {
+        throw cRuntimeError("receptionWindow has to be shorter than wrap-around of CAM generation delta time");
+    }
+
+    mBins.resize(static_cast<std::size_t>(std::ceil(mMaxDistance / mBinSize)));
+    for (unsigned bin = 0; bin < mBins.size(); ++bin) {
+        mBins[bin].gaps.setName(("ipg " + getBinLabel(bin)).c_str());
+    }
+
+    cModule* system = getSystemModule();
+    system->subscribe(IdentityRegistry::updateSignal, this);
+    system->subscribe(IdentityRegistry::removeSignal, this);
+    system->subscribe(scSignalCamSent, this);
+    system->subscribe(scSignalCamReceived, this);
+}
+
+void PrrAnalyzer::finish()
+{
+    cModule* system = getSystemModule();
+    system->unsubscribe(IdentityRegistry::updateSignal, this);
+    system->unsubscribe(IdentityRegistry::removeSignal, this);
+    system->unsubscribe(scSignalCamSent, this);
+    system->unsubscribe(scSignalCamReceived, this);
+
+    for (unsigned bin = 0; bin < mBins.size(); ++bin) {
+        Bin& stats = mBins[bin];
+        const std::string label = getBinLabel(bin);
+        recordScalar(("expected " + label).c_str(), stats.expected);
+        recordScalar(("received " + label).c_str(), stats.received);
+        if (stats.expected > 0) {
+            recordScalar(("prr " + label).c_str(), static_cast<double>(stats.received) / stats.expected);
+        }
+        recordStatistic(&stats.gaps, "s");
+    }
+}
+
+void PrrAnalyzer::receiveSignal(cComponent* source, simsignal_t signal, cObject* obj, cObject*)
+{
+    if (signal == scSignalCamSent || signal == scSignalCamReceived) {
+        // CA services might be nested in compound modules, thus they are mapped to their middleware
+        auto cam = dynamic_cast<CaObject*>(obj);
+        auto service = mCaServices.find(source->getId());
+        if (cam && service != mCaServices.end()) {
+            expire();
+            if (signal == scSignalCamSent) {
+                transmitted(service->second, *cam);
+            } else {
+                received(service->second, *cam);
+            }
+        }
+    } else if (signal == IdentityRegistry::updateSignal) {
+        auto middleware = dynamic_cast<Middleware*>(source);
+        if (middleware) {
+            registerStation(*middleware);
+        }
+    } else if (signal == IdentityRegistry::removeSignal) {
+        removeStation(source->getId());
+    }
+}
+
+void PrrAnalyzer::registerStation(const Middleware& middleware)
+{
+    if (mStationIndex.find(middleware.getId()) == mStationIndex.end()) {
+        Station station;
+        station.services = findCaServices(middleware);
+        if (station.services.empty()) {
+            return;
+        }
+
+        station.middleware = middleware.getId();
+        station.position = &middleware.getFacilities().get_const<PositionProvider>();
+        for (int service : station.services) {
+            mCaServices[service] = station.middleware;
+        }
+        mStationIndex.emplace(station.middleware, mStations.size());
+        mStations.push_back(std::move(station));
+    }
+}
+
+void PrrAnalyzer::removeStation(int middleware)
+{
+    auto found = mStationIndex.find(middleware);
+    if (found != mStationIndex.end()) {
+        const std::size_t index = found->second;
+        mStationIndex.erase(found);
+        for (int service : mStations[index].services) {
+            mCaServices.erase(service);
+        }
+        if (index + 1 != mStations.size()) {
+            mStations[index] = std::move(mStations.back());
+            mStationIndex[mStations[index].middleware] = index;
+        }
+        mStations.pop_back();
+    }
+}
+
+void PrrAnalyzer::transmitted(int middleware, const CaObject& obj)
+{
+    auto sender = mStationIndex.find(middleware);
+    if (sender == mStationIndex.end() || simTime() < getSimulation()->getWarmupPeriod()) {
+        return;
+    }
+
+    Transmission transmission;
+    transmission.sent = simTime();
+    const Position senderPosition = mStations[sender->second].position->getCartesianPosition();
+    for (const Station& station : mStations) {
+        if (station.middleware != middleware) {
+            const double dist = distance(senderPosition, station.position->getCartesianPosition()).value();
+            if (dist < mMaxDistance) {
+                // rounding of the division might yield one bin beyond the last one close to maxDistance
+                const unsigned bin = std::min(static_cast<std::size_t>(dist / mBinSize), mBins.size() - 1);
+                transmission.receivers.push_back(Expectation { station.middleware, bin, false });
+                ++mBins[bin].expected;
+            }
+        }
+    }
+
+    if (!transmission.receivers.empty()) {
+        std::sort(transmission.receivers.begin(), transmission.receivers.end(),
+                [](const Expectation& a, const Expectation& b) { return a.middleware < b.middleware; });
+        const std::uint64_t key = transmissionKey(obj.asn1());
+        mTransmissions[key] = std::move(transmission);
+        mExpiry.emplace_back(simTime() + mWindow, key);
+    }
+}
+
+void PrrAnalyzer::received(int middleware, const CaObject& obj)
+{
+    auto receiver = mStationIndex.find(middleware);
+    auto transmission = mTransmissions.find(transmissionKey(obj.asn1()));
+    if (receiver == mStationIndex.end() || transmission == mTransmissions.end()) {
+        return;
+    }
+
+    auto& receivers = transmission->second.receivers;
+    auto expectation = std::lower_bound(receivers.begin(), receivers.end(), middleware,
+            [](const Expectation& e, int id) { return e.middleware < id; });
+    if (expectation == receivers.end() || expectation->middleware != middleware || expectation->received) {
+        return;
+    }
+
+    Bin& bin = mBins[expectation->bin];
+    expectation->received = true;
+    ++bin.received;
+
+    auto& lastReception = mStations[receiver->second].lastReception;
+    auto inserted = lastReception.emplace(obj.asn1()->header.stationID, simTime());
+    if (!inserted.second) {
+        bin.gaps.collect(simTime() - inserted.first->second);
+        inserted.first->second = simTime();
+    }
+}
+
+void PrrAnalyzer::expire()
+{
+    const SimTime now = simTime();
+    while (!mExpiry.empty() && mExpiry.front().first < now) {
+        auto found = mTransmissions.find(mExpiry.front().second);
+        if (found != mTransmissions.end() && found->second.sent + mWindow <= mExpiry.front().first) {
+            mTransmissions.erase(found);
+        }
+        mExpiry.pop_front();
+    }
+}
+
+std::string PrrAnalyzer::getBinLabel(unsigned bin) const
+{
+    const double lower = bin * mBinSize;
+    const double upper = std::min(lower + mBinSize, mMaxDistance);
+    std::ostringstream label;
+    label << lower << "-" << upper << "m";
+    return label.str();
+}
+
+} // namespace artery
@@ -0,0 +1,87 @@
+#ifndef ARTERY_PRRANALYZER_H_D4HVX6QA
+#define ARTERY_PRRANALYZER_H_D4HVX6QA
+
+#include <omnetpp/chistogram.h>
+#include <omnetpp/clistener.h>
+#include <omnetpp/csimplemodule.h>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace artery
+{
+
+class CaObject;
+class Middleware;
+class PositionProvider;
+
+/**
+ * PrrAnalyzer evaluates CAM packet reception ratio (PRR) and inter-packet gap (IPG) per distance bin
+ *
+ * All stations whose middleware hosts a service emitting CamReceived are potential receivers.
+ * Such services are looked up in the middleware's service list, i.e. they might be nested in compound modules.
+ * Each sent CAM is expected by all potential receivers within maxDistance, binned by their distance
+ * to the sender at transmission time. Receptions are matched to transmissions by the CAM's station ID
+ * and generation delta time. Inter-packet gaps are the times between successive receptions of a
+ * receiver from the same sender. Only compact per-bin counters and histograms are recorded at finish.
+ */
+class PrrAnalyzer : public omnetpp::cSimpleModule, public omnetpp::cListener
+{
+public:
+    void initialize() override;
+    void finish() override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
+
+private:
+    struct Station
+    {
+        int middleware;
+        std::vector<int> services; /*< ids of CA service modules */
+        const PositionProvider* position;
+        std::unordered_map<std::uint32_t, omnetpp::SimTime> lastReception; /*< by sending station ID */
+    };
+
+    struct Expectation
+    {
+        int middleware;
+        unsigned bin;
+        bool received;
+    };
+
+    struct Transmission
+    {
+        omnetpp::SimTime sent;
+        std::vector<Expectation> receivers; /*< sorted by middleware id */
+    };
+
+    struct Bin
+    {
+        unsigned long expected = 0;
+        unsigned long received = 0;
+        omnetpp::cHistogram gaps;
+    };
+
+    void registerStation(const Middleware&);
+    void removeStation(int middleware);
+    void transmitted(int middleware, const CaObject&);
+    void received(int middleware, const CaObject&);
+    void expire();
+    std::string getBinLabel(unsigned bin) const;
+
+    omnetpp::SimTime mWindow;
+    double mBinSize;
+    double mMaxDistance;
+    std::vector<Station> mStations;
+    std::unordered_map<int, std::size_t> mStationIndex; /*< middleware id -> index in mStations */
+    std::unordered_map<int, int> mCaServices; /*< CA service module id -> middleware id */
+    std::unordered_map<std::uint64_t, Transmission> mTransmissions;
+    std::deque<std::pair<omnetpp::SimTime, std::uint64_t>> mExpiry;
+    std::vector<Bin> mBins;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_PRRANALYZER_H_D4HVX6QA */
@@ -97,13 +97,24 @@ void RsuCaService::trigger()
     }
 }
 
-void RsuCaService::indicate(const vanetza::btp::DataIndication& ind, std::unique_ptr<vanetza::UpPacket> packet)
+void RsuCaService::finish()
+{
+    // decoding and validation are shared by all receivers, count only work done by this service
+    recordScalar("camDecodes", mDecodes);
+    recordScalar("camValidations", mValidations);
+    ItsG5BaseService::finish();
+}
+
+void RsuCaService::indicate(const vanetza::btp::DataIndication& ind, std::shared_ptr<const vanetza::UpPacket> packet)
 {
     Enter_Method("indicate");
 
     Asn1PacketVisitor<vanetza::asn1::Cam> visitor;
     const vanetza::asn1::Cam* cam = boost::apply_visitor(visitor, *packet);
-    if (cam && cam->validate()) {
+    const bool valid = cam && visitor.validate();
+    mDecodes += visitor.decoded;
+    mValidations += visitor.validated;
+    if (valid) {
         CaObject obj = visitor.shared_wrapper;
         emit(scSignalCamReceived, &obj);
 
@@ -27,7 +27,9 @@ class RsuCaService : public ItsG5BaseService
 {
     public:
         void initialize() override;
-        void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
+        void finish() override;
+        void indicate(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>) override;
+        bool acceptsSharedIndication() const override { return true; }
         void trigger() override;
 
         struct ProtectedCommunicationZone
@@ -57,6 +59,8 @@ class RsuCaService : public ItsG5BaseService
         std::vector<int> mSizes;
         std::vector<double> mProb;
         std::list<ProtectedCommunicationZone> mProtectedCommunicationZones;
+        unsigned long mDecodes = 0;
+        unsigned long mValidations = 0;
 };
 
 } // namespace artery
@@ -81,10 +81,17 @@ void RsuDenService::receiveSignal(cComponent*, simsignal_t signal, cObject* obj,
     }
 }
 
-void RsuDenService::indicate(const vanetza::btp::DataIndication& indication, std::unique_ptr<vanetza::UpPacket> packet)
+void RsuDenService::finish()
+{
+    recordScalar("denmDecodes", mDecodes);
+    ItsG5BaseService::finish();
+}
+
+void RsuDenService::indicate(const vanetza::btp::DataIndication& indication, std::shared_ptr<const vanetza::UpPacket> packet)
 {
     Asn1PacketVisitor<vanetza::asn1::Denm> visitor;
     const vanetza::asn1::Denm* denm = boost::apply_visitor(visitor, *packet);
+    mDecodes += visitor.decoded;
     const auto egoStationID = mIdentity->application;
 
     if (denm && (*denm)->header.stationID != egoStationID) {
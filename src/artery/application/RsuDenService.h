@@ -30,8 +30,10 @@ class RsuDenService : public ItsG5BaseService
     public:
         RsuDenService();
         void initialize() override;
+        void finish() override;
         void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
-        void indicate(const vanetza::btp::DataIndication&, std::unique_ptr<vanetza::UpPacket>) override;
+        void indicate(const vanetza::btp::DataIndication&, std::shared_ptr<const vanetza::UpPacket>) override;
+        bool acceptsSharedIndication() const override { return true; }
         void trigger() override;
 
         using ItsG5BaseService::getFacilities;
@@ -51,6 +53,7 @@ class RsuDenService : public ItsG5BaseService
         uint16_t mSequenceNumber;
         std::shared_ptr<artery::den::Memory> mMemory;
         std::list<artery::den::RsuUseCase*> mUseCases;
+        unsigned long mDecodes = 0;
 };
 
 } // namespace artery
@@ -1,11 +1,14 @@
 #ifndef ARTERY_SAMPLEBUFFER_H_QHFTL7Z2
 #define ARTERY_SAMPLEBUFFER_H_QHFTL7Z2
 
-#include <boost/circular_buffer.hpp>
-#include <boost/range/iterator_range_core.hpp>
+#include <boost/iterator/iterator_facade.hpp>
 #include <omnetpp/simtime.h>
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory>
 #include <stdexcept>
+#include <utility>
 
 template<typename T>
 struct Sample
@@ -22,73 +25,319 @@ struct Sample
 };
 
 template<typename T>
-class SampleBuffer
+class SampleBuffer;
+
+/**
+ * Random access iterator over samples of a buffer, newest sample first
+ *
+ * Samples are stored column-wise, thus dereferencing yields a Sample by value.
+ */
+template<typename T>
+class SampleIterator : public boost::iterator_facade<
+    SampleIterator<T>, Sample<T>, boost::random_access_traversal_tag, Sample<T>, std::ptrdiff_t>
 {
 public:
-    using sample_type = T;
+    SampleIterator() = default;
+    SampleIterator(const SampleBuffer<T>* buffer, std::size_t age) : m_buffer(buffer), m_age(age) {}
+
+    /**
+     * Age of referenced sample, i.e. 0 for the latest sample
+     */
+    std::size_t age() const { return m_age; }
+
+private:
+    friend class boost::iterator_core_access;
+
+    Sample<T> dereference() const { return m_buffer->sample(m_age); }
+    bool equal(const SampleIterator& other) const { return m_age == other.m_age; }
+    void increment() { ++m_age; }
+    void decrement() { --m_age; }
+    void advance(std::ptrdiff_t n) { m_age += n; }
+    std::ptrdiff_t distance_to(const SampleIterator& other) const
+    {
+        return static_cast<std::ptrdiff_t>(other.m_age) - static_cast<std::ptrdiff_t>(m_age);
+    }
+
+    const SampleBuffer<T>* m_buffer = nullptr;
+    std::size_t m_age = 0;
+};
+
+/**
+ * Range of the newest samples of a buffer
+ */
+template<typename T>
+class SampleRange
+{
+public:
+    using iterator = SampleIterator<T>;
+    using const_iterator = iterator;
     using value_type = Sample<T>;
-    using buffer_type = boost::circular_buffer<value_type>;
-    using iterator = typename buffer_type::const_iterator;
 
-    struct range : public boost::iterator_range<iterator>
+    SampleRange(const SampleBuffer<T>& buffer, std::size_t count) : m_buffer(&buffer), m_count(count) {}
+
+    iterator begin() const { return iterator(m_buffer, 0); }
+    iterator end() const { return iterator(m_buffer, m_count); }
+    std::size_t size() const { return m_count; }
+    bool empty() const { return m_count == 0; }
+
+    omnetpp::SimTime duration() const
     {
-        range(iterator begin, iterator end) :
-            boost::iterator_range<iterator>(begin, end)
-        {
+        auto d = omnetpp::SimTime::ZERO;
+        if (m_count >= 2) {
+            d = m_buffer->timestamp(0) - m_buffer->timestamp(m_count - 1);
         }
+        return d;
+    }
 
-        omnetpp::SimTime duration() const
-        {
-            auto d = omnetpp::SimTime::ZERO;
-            if (range::size() >= 2) {
-                d = range::begin()->timestamp - std::prev(range::end())->timestamp;
+    /**
+     * Mean value of samples in range, calculated from running sums in constant time
+     */
+    T mean() const
+    {
+        T avg {};
+        if (m_count > 0) {
+            avg = m_buffer->sum(m_count) / static_cast<double>(m_count);
+        }
+        return avg;
+    }
+
+private:
+    const SampleBuffer<T>* m_buffer;
+    std::size_t m_count;
+};
+
+/**
+ * SampleBuffer keeps the most recent samples in chronological order
+ *
+ * Values and timestamps are stored in separate ring arrays allocated once when capacity is set,
+ * i.e. inserting samples does not allocate memory. Running sums as well as sliding minimum and maximum
+ * are updated on each insertion, thus T has to support addition, subtraction and comparison.
+ */
+template<typename T>
+class SampleBuffer
+{
+public:
+    using sample_type = T;
+    using value_type = Sample<T>;
+    using iterator = SampleIterator<T>;
+    using range = SampleRange<T>;
+
+    /**
+     * Set capacity of buffer, the newest samples are kept
+     * \param n maximum number of samples
+     */
+    void set_capacity(std::size_t n)
+    {
+        if (n != m_capacity) {
+            SampleBuffer resized;
+            resized.allocate(n);
+            for (std::size_t age = std::min(n, m_size); age > 0; --age) {
+                resized.push(value(age - 1), timestamp(age - 1));
             }
-            return d;
+            *this = std::move(resized);
         }
-    };
+    }
 
-    void set_capacity(std::size_t n) { m_buffer.set_capacity(n); }
-    std::size_t size() const { return m_buffer.size(); }
-    bool empty() const { return m_buffer.empty(); }
-    bool full() const { return m_buffer.full(); }
-    iterator begin() const { return iterator(m_buffer.begin()); }
-    iterator end() const { return iterator(m_buffer.end()); }
+    std::size_t capacity() const { return m_capacity; }
+    std::size_t size() const { return m_size; }
+    bool empty() const { return m_size == 0; }
+    bool full() const { return m_size == m_capacity; }
+    iterator begin() const { return iterator(this, 0); }
+    iterator end() const { return iterator(this, m_size); }
 
-    const value_type& latest() const { return m_buffer.front(); }
+    value_type latest() const { return sample(0); }
 
+    /**
+     * Get sample of given age
+     * \param age 0 for the latest sample, size() - 1 for the oldest one
+     */
+    value_type sample(std::size_t age) const { return value_type { value(age), timestamp(age) }; }
+    const T& value(std::size_t age) const { return m_values[slot(age)]; }
+    omnetpp::SimTime timestamp(std::size_t age) const { return m_timestamps[slot(age)]; }
+
+    /**
+     * Minimum and maximum value of all buffered samples, buffer must not be empty
+     */
+    const T& min() const { return m_values[m_minima.front()]; }
+    const T& max() const { return m_values[m_maxima.front()]; }
+
+    /**
+     * Sum of values of the newest samples
+     * \param count number of samples, at most size()
+     */
+    T sum(std::size_t count) const
+    {
+        T s {};
+        if (count > 0) {
+            const std::size_t oldest = slot(count - 1);
+            s = m_sums[slot(0)] - m_sums[oldest] + m_values[oldest];
+        }
+        return s;
+    }
+
+    /**
+     * Find the newest sample taken at or before the given time
+     * \param limit time limit
+     * \return iterator to sample or end() if all samples are newer
+     */
+    iterator at_or_before(omnetpp::SimTime limit) const
+    {
+        return iterator(this, count_newest([limit](omnetpp::SimTime t) { return t > limit; }));
+    }
+
+    /**
+     * Range of all samples taken after the given time
+     */
     range not_before(omnetpp::SimTime limit) const
     {
-        iterator begin = m_buffer.begin();
-        iterator end = std::lower_bound(m_buffer.begin(), m_buffer.end(), limit,
-                [](const value_type& sample, const omnetpp::SimTime& limit) { return sample.timestamp > limit; });
-        return range(begin, end);
+        return range(*this, count_newest([limit](omnetpp::SimTime t) { return t > limit; }));
     }
 
     void insert(const sample_type& sample, omnetpp::SimTime timestamp)
     {
-        insert_impl(sample, timestamp);
+        if (m_size == 0 || this->timestamp(0) < timestamp) {
+            push(sample, timestamp);
+        } else {
+            throw std::logic_error("chronological order of samples violated");
+        }
     }
 
-    void insert(sample_type&& sample, omnetpp::SimTime timestamp)
+    void clear()
     {
-        insert_impl(std::move(sample), timestamp);
+        m_size = 0;
+        m_minima.clear();
+        m_maxima.clear();
     }
 
-    void clear() { m_buffer.clear(); }
-
 private:
-    template<typename S>
-    void insert_impl(S&& sample, omnetpp::SimTime timestamp)
+    /**
+     * Ring of slot indices with fixed capacity, used as monotonic wedge
+     */
+    class SlotQueue
+    {
+    public:
+        void allocate(std::size_t n) { m_slots.reset(n > 0 ? new std::size_t[n] : nullptr); m_capacity = n; clear(); }
+        void clear() { m_head = 0; m_size = 0; }
+        bool empty() const { return m_size == 0; }
+        std::size_t front() const { return m_slots[m_head]; }
+        std::size_t back() const { return m_slots[(m_head + m_size - 1) % m_capacity]; }
+        void pop_front() { m_head = (m_head + 1) % m_capacity; --m_size; }
+        void pop_back() { --m_size; }
+        void push_back(std::size_t slot) { m_slots[(m_head + m_size++) % m_capacity] = slot; }
+
+    private:
+        std::unique_ptr<std::size_t[]> m_slots;
+        std::size_t m_capacity = 0;
+        std::size_t m_head = 0;
+        std::size_t m_size = 0;
+    };
+
+    void allocate(std::size_t n)
+    {
+        m_values.reset(n > 0 ? new T[n] : nullptr);
+        m_sums.reset(n > 0 ? new T[n] : nullptr);
+        m_timestamps.reset(n > 0 ? new omnetpp::SimTime[n] : nullptr);
+        m_minima.allocate(n);
+        m_maxima.allocate(n);
+        m_capacity = n;
+        m_newest = 0;
+        m_size = 0;
+    }
+
+    std::size_t slot(std::size_t age) const
+    {
+        return (m_newest + m_capacity - age) % m_capacity;
+    }
+
+    /**
+     * Count newest samples whose timestamps satisfy a predicate by binary search
+     * \param pred predicate, which has to hold for a prefix of samples ordered by age
+     */
+    template<typename PRED>
+    std::size_t count_newest(PRED pred) const
+    {
+        std::size_t first = 0;
+        std::size_t last = m_size;
+        while (first < last) {
+            const std::size_t mid = first + (last - first) / 2;
+            if (pred(timestamp(mid))) {
+                first = mid + 1;
+            } else {
+                last = mid;
+            }
+        }
+        return first;
+    }
+
+    /**
+     * Recompute running sums starting at the oldest sample
+     *
+     * Adding and subtracting values accumulates rounding errors in floating-point sums.
+     * Rebasing each time the ring wraps bounds these errors at amortised constant cost.
+     */
+    void rebase_sums()
+    {
+        T running {};
+        for (std::size_t age = m_size; age > 0; --age) {
+            const std::size_t oldest = slot(age - 1);
+            running = running + m_values[oldest];
+            m_sums[oldest] = running;
+        }
+    }
+
+    void push(const T& value, omnetpp::SimTime timestamp)
     {
-        if (m_buffer.empty() || m_buffer.front().timestamp < timestamp) {
-            m_buffer.push_front(value_type { std::forward<S>(sample), timestamp });
+        if (m_capacity == 0) {
+            return;
+        }
+
+        const T previous_sum = m_size > 0 ? m_sums[m_newest] : T {};
+        if (m_size == m_capacity) {
+            // evict oldest sample, its slot is reused for the new sample unless capacity is one
+            const std::size_t oldest = slot(m_size - 1);
+            if (m_minima.front() == oldest) {
+                m_minima.pop_front();
+            }
+            if (m_maxima.front() == oldest) {
+                m_maxima.pop_front();
+            }
+            --m_size;
+        }
+
+        // running sums start anew with an empty buffer
+        if (m_size > 0) {
+            m_newest = (m_newest + 1) % m_capacity;
+            m_sums[m_newest] = previous_sum + value;
         } else {
-            throw std::logic_error("chronological order of samples violated");
+            m_newest = 0;
+            m_sums[m_newest] = value;
+        }
+        m_values[m_newest] = value;
+        m_timestamps[m_newest] = timestamp;
+        ++m_size;
+
+        if (m_newest == 0) {
+            rebase_sums();
+        }
+
+        while (!m_minima.empty() && !(m_values[m_minima.back()] < value)) {
+            m_minima.pop_back();
         }
+        m_minima.push_back(m_newest);
+        while (!m_maxima.empty() && !(value < m_values[m_maxima.back()])) {
+            m_maxima.pop_back();
+        }
+        m_maxima.push_back(m_newest);
     }
 
-    buffer_type m_buffer;
+    std::unique_ptr<T[]> m_values;
+    std::unique_ptr<T[]> m_sums; /*< running sums of values up to each slot */
+    std::unique_ptr<omnetpp::SimTime[]> m_timestamps;
+    SlotQueue m_minima; /*< slots with ascending values, front is minimum */
+    SlotQueue m_maxima; /*< slots with descending values, front is maximum */
+    std::size_t m_capacity = 0;
+    std::size_t m_newest = 0;
+    std::size_t m_size = 0;
 };
 
 #endif /* ARTERY_SAMPLEBUFFER_H_QHFTL7Z2 */
-
@@ -1,6 +1,8 @@
 #ifndef ARTERY_SAMPLEBUFFERALGORITHM_H_HIUNJPAK
 #define ARTERY_SAMPLEBUFFERALGORITHM_H_HIUNJPAK
 
+#include "artery/application/SampleBuffer.h"
+#include <boost/range/value_type.hpp>
 #include <boost/units/operators.hpp>
 #include <boost/units/quantity.hpp>
 #include <boost/units/systems/si/time.hpp>
@@ -46,5 +48,11 @@ VALUE average(RANGE r)
     return avg;
 }
 
+template<typename T>
+T average(const SampleRange<T>& r)
+{
+    return r.mean();
+}
+
 #endif /* ARTERY_SAMPLEBUFFERALGORITHM_H_HIUNJPAK */
 
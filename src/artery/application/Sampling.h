@@ -4,6 +4,7 @@
 #include "artery/application/SampleBuffer.h"
 #include <omnetpp/simtime.h>
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
 
 template<typename IN, typename OUT = IN>
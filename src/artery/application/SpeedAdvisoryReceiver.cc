@@ -72,8 +72,6 @@ void SpeedAdvisoryReceiver::indicate(const vanetza::btp::DataIndication&, cPacke
     bool relevance = false;
 
     auto& vehicleController = getFacilities().get_mutable<traci::VehicleController>();
-    const std::string id = vehicleController.getVehicleId();
-    auto& vehicle_api = vehicleController.getTraCI()->vehicle;
 
     double heading = mVehicleDataProvider->heading().value();
 
@@ -131,7 +129,7 @@ void SpeedAdvisoryReceiver::indicate(const vanetza::btp::DataIndication&, cPacke
             double time = dist/speed; // This is slightly simplified given it doesn't account for the nature of the road
 
             // Take action on message
-            vehicle_api.slowDown(id, speedAdvice, 30);
+            vehicleController.slowDown(speedAdvice * si::meter_per_second, 30.0 * si::seconds);
 
             if (negative) {
                 dist = dist * -1;
@@ -4,6 +4,8 @@
 #include "artery/application/TransportDispatcher.h"
 #include <omnetpp/clog.h>
 #include <vanetza/btp/header.hpp>
+#include <vanetza/net/packet_variant.hpp>
+#include <algorithm>
 
 using namespace vanetza;
 
@@ -18,7 +20,7 @@ void TransportDispatcher::indicate(const geonet::DataIndication& gn_ind, std::un
         btp::DataIndication btp_ind(gn_ind, hdr);
 
         // indicate promiscuous listeners
-        auto found_channel = mPromiscuousListeners.find(net.channel);
+        auto found_channel = mPromiscuousListeners.find(net.getChannel());
         if (found_channel != mPromiscuousListeners.end()) {
             for (TappingInterface* listener : found_channel->second) {
                 listener->tap(btp_ind, *packet, net);
@@ -26,17 +28,34 @@ void TransportDispatcher::indicate(const geonet::DataIndication& gn_ind, std::un
         }
 
         // indicate regular listeners
-        auto found_descriptor = mListeners.find(std::make_tuple(net.channel, btp_ind.destination_port.host()));
+        auto found_descriptor = mListeners.find(std::make_tuple(net.getChannel(), btp_ind.destination_port.host()));
         if (found_descriptor != mListeners.end()) {
-            unsigned pending = found_descriptor->second.size();
-            for (IndicationInterface* listener : found_descriptor->second) {
-                if (pending > 1) {
-                    std::unique_ptr<vanetza::UpPacket> dup { new vanetza::UpPacket { *packet } };
-                    listener->indicate(btp_ind, std::move(dup), net);
-                } else {
+            const auto& listeners = found_descriptor->second;
+            unsigned pending_shared = std::count_if(listeners.begin(), listeners.end(),
+                    [](const IndicationInterface* listener) { return listener->acceptsSharedIndication(); });
+            unsigned pending_exclusive = listeners.size() - pending_shared;
+
+            // listeners accepting shared packets get the same (immutable) packet
+            std::shared_ptr<const UpPacket> shared;
+            for (IndicationInterface* listener : listeners) {
+                if (listener->acceptsSharedIndication()) {
+                    if (!shared) {
+                        shared = std::move(packet);
+                    }
+                    --pending_shared;
+                    ++mStatistics.sharedIndications;
+                    listener->indicate(btp_ind, shared, net);
+                } else if (packet && --pending_exclusive == 0 && pending_shared == 0) {
+                    // last listener of all -> pass "original" packet
                     listener->indicate(btp_ind, std::move(packet), net);
+                } else {
+                    // copy on demand for listeners requiring exclusive ownership
+                    const UpPacket& origin = packet ? *packet : *shared;
+                    std::unique_ptr<UpPacket> dup { new UpPacket { origin } };
+                    ++mStatistics.copies;
+                    mStatistics.copiedBytes += size(origin, OsiLayer::Transport, OsiLayer::Application);
+                    listener->indicate(btp_ind, std::move(dup), net);
                 }
-                --pending;
             }
         }
     } else {
@@ -44,9 +44,22 @@ class TransportDispatcher
          */
         void addPromiscuousListener(TappingInterface*, ChannelNumber ch = channel::CCH);
 
+        /**
+         * Statistics about packets copied for listeners requiring exclusive ownership
+         */
+        struct Statistics
+        {
+            unsigned long copies = 0;
+            unsigned long copiedBytes = 0;
+            unsigned long sharedIndications = 0;
+        };
+
+        const Statistics& getStatistics() const { return mStatistics; }
+
     private:
         std::map<TransportDescriptor, std::set<IndicationInterface*>> mListeners;
         std::map<ChannelNumber, std::set<TappingInterface*>> mPromiscuousListeners;
+        mutable Statistics mStatistics;
 };
 
 } // namespace artery
@@ -1,10 +1,17 @@
 #include "artery/application/XmlMultiChannelPolicy.h"
 #include <boost/lexical_cast.hpp>
 #include <omnetpp/cexception.h>
+#include <algorithm>
 
 namespace artery
 {
 
+namespace
+{
+// ITS-AIDs below this limit are mapped by a directly indexed table
+const std::size_t sMaxDenseItsAid = 1024;
+}
+
 XmlMultiChannelPolicy::XmlMultiChannelPolicy(const omnetpp::cXMLElement* cfg)
 {
     read(cfg);
@@ -12,13 +19,13 @@ XmlMultiChannelPolicy::XmlMultiChannelPolicy(const omnetpp::cXMLElement* cfg)
 
 void XmlMultiChannelPolicy::read(const omnetpp::cXMLElement* cfg)
 {
-    mApplicationMapping.clear();
-    mDefaultChannel = 0;
+    std::map<vanetza::ItsAid, std::set<ChannelNumber>> mapping;
+    ChannelNumber defaultChannel = 0;
 
     if (cfg && strcmp(cfg->getTagName(), "mco") == 0) {
         const char* default_channel_attr = cfg->getAttribute("default");
         if (default_channel_attr) {
-            mDefaultChannel = parseChannelNumber(default_channel_attr);
+            defaultChannel = parseChannelNumber(default_channel_attr);
         }
 
         for (const omnetpp::cXMLElement* app : cfg->getChildrenByTagName("application"))
@@ -35,27 +42,63 @@ void XmlMultiChannelPolicy::read(const omnetpp::cXMLElement* cfg)
 
             auto aid = boost::lexical_cast<vanetza::ItsAid>(id_attr);
             auto channel = parseChannelNumber(ch_attr);
-            mApplicationMapping[aid].insert(channel);
+            mapping[aid].insert(channel);
         }
     } else {
         throw omnetpp::cRuntimeError("XML MCO configuration does not start with mco tag");
     }
+
+    compile(mapping, defaultChannel);
 }
 
-std::vector<ChannelNumber> XmlMultiChannelPolicy::allChannels(vanetza::ItsAid aid) const
+void XmlMultiChannelPolicy::compile(const std::map<vanetza::ItsAid, std::set<ChannelNumber>>& mapping, ChannelNumber defaultChannel)
 {
-    std::vector<ChannelNumber> channels;
+    mChannels.clear();
+    mDenseMapping.clear();
+    mSparseMapping.clear();
 
-    auto found = mApplicationMapping.find(aid);
-    if (found != mApplicationMapping.end()) {
-        channels.insert(channels.end(), found->second.begin(), found->second.end());
-    } else {
-        if (mDefaultChannel != 0) {
-            channels.push_back(mDefaultChannel);
+    mDefaultChannels = Slice { 0, 0 };
+    if (defaultChannel != 0) {
+        mChannels.push_back(defaultChannel);
+        mDefaultChannels.second = 1;
+    }
+
+    // ITS-AIDs without explicit mapping fall back to default channel
+    mDenseMapping.assign(std::min<std::size_t>(sMaxDenseItsAid, mapping.empty() ? 0 : mapping.rbegin()->first + 1), mDefaultChannels);
+    for (const auto& aid_channels : mapping) {
+        const Slice slice(mChannels.size(), aid_channels.second.size());
+        mChannels.insert(mChannels.end(), aid_channels.second.begin(), aid_channels.second.end());
+        if (aid_channels.first < mDenseMapping.size()) {
+            mDenseMapping[aid_channels.first] = slice;
+        } else {
+            // std::map iteration yields ascending ITS-AIDs, i.e. sorted sparse mapping
+            mSparseMapping.emplace_back(aid_channels.first, slice);
         }
     }
+}
 
-    return channels;
+XmlMultiChannelPolicy::Slice XmlMultiChannelPolicy::lookup(vanetza::ItsAid aid) const
+{
+    if (aid < mDenseMapping.size()) {
+        return mDenseMapping[aid];
+    }
+
+    auto found = std::lower_bound(mSparseMapping.begin(), mSparseMapping.end(), aid,
+            [](const std::pair<vanetza::ItsAid, Slice>& entry, vanetza::ItsAid aid) { return entry.first < aid; });
+    return found != mSparseMapping.end() && found->first == aid ? found->second : mDefaultChannels;
+}
+
+std::vector<ChannelNumber> XmlMultiChannelPolicy::allChannels(vanetza::ItsAid aid) const
+{
+    const auto range = channels(aid);
+    return std::vector<ChannelNumber>(range.begin(), range.end());
+}
+
+XmlMultiChannelPolicy::ChannelRange XmlMultiChannelPolicy::channels(vanetza::ItsAid aid) const
+{
+    const Slice slice = lookup(aid);
+    const ChannelNumber* first = mChannels.data() + slice.first;
+    return ChannelRange { first, first + slice.second };
 }
 
 } // namespace artery
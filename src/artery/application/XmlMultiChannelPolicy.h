@@ -3,8 +3,11 @@
 
 #include "artery/application/MultiChannelPolicy.h"
 #include <omnetpp/cxmlelement.h>
+#include <cstdint>
 #include <map>
 #include <set>
+#include <utility>
+#include <vector>
 
 namespace artery
 {
@@ -21,10 +24,20 @@ class XmlMultiChannelPolicy : public MultiChannelPolicy
         void read(const omnetpp::cXMLElement*);
 
         std::vector<ChannelNumber> allChannels(vanetza::ItsAid aid) const override;
+        ChannelRange channels(vanetza::ItsAid aid) const override;
 
     private:
-        std::map<vanetza::ItsAid, std::set<ChannelNumber>> mApplicationMapping;
-        ChannelNumber mDefaultChannel;
+        using Slice = std::pair<std::uint32_t, std::uint32_t>; /*< offset and length in mChannels */
+
+        void compile(const std::map<vanetza::ItsAid, std::set<ChannelNumber>>&, ChannelNumber defaultChannel);
+        Slice lookup(vanetza::ItsAid aid) const;
+
+        // all channel lists stored back to back
+        std::vector<ChannelNumber> mChannels;
+        // dense table for small ITS-AIDs, sorted table for remaining ones
+        std::vector<Slice> mDenseMapping;
+        std::vector<std::pair<vanetza::ItsAid, Slice>> mSparseMapping;
+        Slice mDefaultChannels { 0, 0 };
 };
 
 } // namespace artery
@@ -60,11 +60,9 @@ bool EmergencyBrakeLight::checkEgoSpeed() const
 
 bool EmergencyBrakeLight::checkEgoDeceleration() const
 {
+    // all samples are below threshold if their maximum is below threshold
     const auto& samples = mAccelerationSampler.buffer();
-    return samples.full() && std::all_of(samples.begin(), samples.end(),
-        [this](const Sample<vanetza::units::Acceleration>& sample) -> bool {
-            return sample.value < mDecelerationThreshold;
-        });
+    return samples.full() && !samples.empty() && samples.max() < mDecelerationThreshold;
 }
 
 vanetza::asn1::Denm EmergencyBrakeLight::createMessage()
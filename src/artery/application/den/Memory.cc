@@ -6,7 +6,12 @@
 
 #include "artery/application/den/Memory.h"
 #include "artery/application/Timer.h"
+#include <boost/functional/hash.hpp>
 #include <omnetpp/csimulation.h>
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+#include <string>
 
 using omnetpp::SimTime;
 
@@ -35,34 +40,40 @@ bool operator==(const ActionID& lhs, const ActionID& rhs)
     return lhs.station_id == rhs.station_id && lhs.sequence_number == rhs.sequence_number;
 }
 
-bool operator<(const INTEGER_t& lhs, const INTEGER_t& rhs)
+std::size_t hash_value(const ActionID& id)
 {
-    // TODO this might fail because long is not wide enough (asn1c limitation)
-    long lhs_value = 0, rhs_value = 0;
-    if (asn_INTEGER2long(&lhs, &lhs_value) != 0) {
-        throw std::range_error("lhs value cannot be converted to long");
-    }
-    if (asn_INTEGER2long(&rhs, &rhs_value) != 0) {
-        throw std::range_error("rhs value cannot be converted to long");
-    }
-
-    return lhs_value < rhs_value;
+    std::size_t seed = 0;
+    boost::hash_combine(seed, id.station_id);
+    boost::hash_combine(seed, id.sequence_number);
+    return seed;
 }
 
-Reception::Reception(const DenmObject& object) :
-    timestamp(omnetpp::simTime()),
-    message(object.shared_ptr())
+namespace
+{
+
+std::uint64_t decode(const INTEGER_t& integer, const char* field)
 {
+    unsigned long value = 0;
+    if (asn_INTEGER2ulong(&integer, &value) != 0) {
+        throw std::range_error(std::string("DENM ") + field + " cannot be converted to unsigned long");
+    }
+    return value;
 }
 
-vanetza::Clock::time_point Reception::expiry() const
+CauseCode decode_cause_code(const vanetza::asn1::Denm& denm)
 {
-    unsigned long detectionTimeRaw = 0;
-    const ManagementContainer_t& denmManagement = (*message)->denm.management;
-    if (asn_INTEGER2ulong(&denmManagement.detectionTime, &detectionTimeRaw) != 0) {
-        throw std::range_error("DENM detectionTime cannot be converted to unsigned long");
+    const SituationContainer* situation = denm->denm.situation;
+    if (situation) {
+        return convert(situation->eventType.causeCode);
+    } else {
+        return static_cast<CauseCode>(0);
     }
-    vanetza::Clock::time_point detectionTime { std::chrono::milliseconds(detectionTimeRaw) };
+}
+
+vanetza::Clock::time_point decode_expiry(const vanetza::asn1::Denm& denm)
+{
+    const ManagementContainer_t& denmManagement = denm->denm.management;
+    vanetza::Clock::time_point detectionTime { std::chrono::milliseconds(decode(denmManagement.detectionTime, "detectionTime")) };
 
     vanetza::Clock::duration validityDuration = std::chrono::seconds(600);
     if (denmManagement.validityDuration) {
@@ -72,19 +83,16 @@ vanetza::Clock::time_point Reception::expiry() const
     return detectionTime + validityDuration;
 }
 
-ActionID Reception::action_id() const
-{
-    return ActionID((*message)->denm.management.actionID);
-}
+} // namespace
 
-CauseCode Reception::cause_code() const
+Reception::Reception(const DenmObject& object) :
+    timestamp(omnetpp::simTime()),
+    message(object.shared_ptr()),
+    m_action_id((*message)->denm.management.actionID),
+    m_cause_code(decode_cause_code(*message)),
+    m_expiry(decode_expiry(*message)),
+    m_reference_time(decode((*message)->denm.management.referenceTime, "referenceTime"))
 {
-    const SituationContainer* situation = (*message)->denm.situation;
-    if (situation) {
-        return convert(situation->eventType.causeCode);
-    } else {
-        return static_cast<CauseCode>(0);
-    }
 }
 
 Memory::Memory(const Timer& timer) :
@@ -99,21 +107,59 @@ void Memory::received(const DenmObject& denm)
     auto& idx_action_id = m_container.get<by_action_id>();
     auto found = idx_action_id.find(action_id);
     if (found == idx_action_id.end()) {
-        m_container.insert(den::Reception {denm});
+        auto inserted = m_container.insert(den::Reception {denm});
+        const vanetza::Clock::time_point expiry = inserted.first->expiry();
+        m_expiries[bucket(expiry)].push_back(Expiry { action_id, expiry });
     } else {
-        const ManagementContainer_t& stored = (*found->message)->denm.management;
-        const ManagementContainer_t& received = denm.asn1()->denm.management;
-        if (stored.referenceTime < received.referenceTime) {
-            idx_action_id.replace(found, den::Reception {denm});
+        den::Reception reception { denm };
+        if (found->reference_time() < reception.reference_time()) {
+            const vanetza::Clock::time_point expiry = reception.expiry();
+            idx_action_id.replace(found, std::move(reception));
+            m_expiries[bucket(expiry)].push_back(Expiry { action_id, expiry });
         }
     }
 }
 
 void Memory::drop()
 {
-    auto& idx_expiry = m_container.get<by_expiry>();
-    auto first_not_less = idx_expiry.lower_bound(m_timer.getCurrentTime());
-    idx_expiry.erase(idx_expiry.begin(), first_not_less);
+    const vanetza::Clock::time_point now = m_timer.getCurrentTime();
+    auto& idx_action_id = m_container.get<by_action_id>();
+    auto is_current = [&idx_action_id](const Expiry& entry) {
+        auto found = idx_action_id.find(entry.action_id);
+        return found != idx_action_id.end() && found->expiry() == entry.expiry ? found : idx_action_id.end();
+    };
+
+    // buckets ending before now contain expired receptions only
+    const std::int64_t now_bucket = bucket(now);
+    auto it = m_expiries.begin();
+    for (; it != m_expiries.end() && it->first < now_bucket; ++it) {
+        for (const Expiry& entry : it->second) {
+            auto found = is_current(entry);
+            if (found != idx_action_id.end()) {
+                idx_action_id.erase(found);
+            }
+        }
+    }
+    m_expiries.erase(m_expiries.begin(), it);
+
+    // bucket of current time may contain expired receptions as well
+    if (it != m_expiries.end() && it->first == now_bucket) {
+        auto& entries = it->second;
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+            [&](const Expiry& entry) {
+                if (entry.expiry < now) {
+                    auto found = is_current(entry);
+                    if (found != idx_action_id.end()) {
+                        idx_action_id.erase(found);
+                    }
+                    return true;
+                }
+                return false;
+            }), entries.end());
+        if (entries.empty()) {
+            m_expiries.erase(it);
+        }
+    }
 }
 
 unsigned Memory::count(CauseCode cause_code) const
@@ -129,5 +175,10 @@ auto Memory::messages(CauseCode cause_code) const -> boost::iterator_range<cause
     return boost::make_iterator_range(equal_cause_code);
 }
 
+std::int64_t Memory::bucket(vanetza::Clock::time_point tp)
+{
+    return std::chrono::duration_cast<std::chrono::seconds>(tp.time_since_epoch()).count();
+}
+
 } // namespace den
 } // namespace artery
@@ -9,13 +9,16 @@
 
 #include "artery/application/DenmObject.h"
 #include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/mem_fun.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/range/iterator_range_core.hpp>
 #include <omnetpp/simtime.h>
 #include <vanetza/asn1/denm.hpp>
 #include <vanetza/common/clock.hpp>
+#include <cstdint>
+#include <map>
 #include <memory>
+#include <vector>
 
 namespace artery
 {
@@ -35,7 +38,11 @@ struct ActionID
 
 bool operator<(const ActionID&, const ActionID&);
 bool operator==(const ActionID&, const ActionID&);
+std::size_t hash_value(const ActionID&);
 
+/**
+ * Received DENM with its management fields decoded once at reception
+ */
 struct Reception
 {
     Reception(const DenmObject&);
@@ -43,29 +50,44 @@ struct Reception
     omnetpp::SimTime timestamp;
     std::shared_ptr<const vanetza::asn1::Denm> message;
 
-    vanetza::Clock::time_point expiry() const;
-    ActionID action_id() const;
-    CauseCode cause_code() const;
+    vanetza::Clock::time_point expiry() const { return m_expiry; }
+    ActionID action_id() const { return m_action_id; }
+    CauseCode cause_code() const { return m_cause_code; }
+    std::uint64_t reference_time() const { return m_reference_time; }
+
+private:
+    ActionID m_action_id;
+    CauseCode m_cause_code;
+    vanetza::Clock::time_point m_expiry;
+    std::uint64_t m_reference_time;
 };
 
 class Memory
 {
     struct by_action_id {};
-    struct by_expiry {};
     struct by_cause_code {};
 
     using container_type = boost::multi_index_container<Reception,
         boost::multi_index::indexed_by<
-            boost::multi_index::ordered_unique<
+            boost::multi_index::hashed_unique<
                 boost::multi_index::tag<by_action_id>,
                 boost::multi_index::const_mem_fun<Reception, ActionID, &Reception::action_id>>,
-            boost::multi_index::ordered_non_unique<
-                boost::multi_index::tag<by_expiry>,
-                boost::multi_index::const_mem_fun<Reception, vanetza::Clock::time_point, &Reception::expiry>>,
-            boost::multi_index::ordered_non_unique<
+            boost::multi_index::hashed_non_unique<
                 boost::multi_index::tag<by_cause_code>,
                 boost::multi_index::const_mem_fun<Reception, CauseCode, &Reception::cause_code>>
         >>;
+
+    struct Expiry
+    {
+        ActionID action_id;
+        vanetza::Clock::time_point expiry;
+    };
+
+    /**
+     * Expiries are bucketed by whole seconds, only the oldest pending bucket is scanned at drop.
+     * Entries of replaced receptions stay in their buckets and are skipped at drop.
+     */
+    using expiry_buckets = std::map<std::int64_t, std::vector<Expiry>>;
 public:
     using cause_code_iterator = decltype(container_type().get<by_cause_code>().begin());
 
@@ -77,8 +99,11 @@ public:
     boost::iterator_range<cause_code_iterator> messages(CauseCode) const;
 
 private:
+    static std::int64_t bucket(vanetza::Clock::time_point);
+
     const Timer& m_timer;
     container_type m_container;
+    expiry_buckets m_expiries;
 };
 
 } // namespace den
@@ -126,10 +126,8 @@ void ObuRwwLaneClosure::indicate(const artery::DenmObject& denm){
             auto status = asn1->denm.alacarte->roadWorks->closedLanes->drivingLaneStatus;
 
             auto vehicleController = &mService->getFacilities().get_mutable<traci::VehicleController>();
-            const std::string id = vehicleController->getVehicleId();
-            auto& vehicle_api = vehicleController->getTraCI()->vehicle;
             // Do something with this.
-            vehicle_api.slowDown(id, 22.22, 30);
+            vehicleController->slowDown(22.22 * boost::units::si::meter_per_second, 30.0 * boost::units::si::seconds);
         }
     }
 }
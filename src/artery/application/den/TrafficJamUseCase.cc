@@ -95,7 +95,9 @@ bool TrafficJamEndOfQueue::checkEgoDeceleration() const
     const auto& velocitySamples = mVelocitySampler.buffer();
 
     // current velocity shall not exceed target velocity
-    if (!velocitySamples.empty() && velocitySamples.latest().value <= targetVelocityThreshold) {
+    // skip search if not any buffered sample reaches initial velocity threshold
+    if (!velocitySamples.empty() && velocitySamples.latest().value <= targetVelocityThreshold &&
+            velocitySamples.max() >= initialVelocityThreshold) {
         // find the newest sample above initial velocity threshold
         auto initialVelocity = std::find_if(std::next(velocitySamples.begin()), velocitySamples.end(),
                 [](const Sample<Velocity>& s) { return s.value >= initialVelocityThreshold; });
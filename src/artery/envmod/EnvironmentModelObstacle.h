@@ -7,40 +7,17 @@
 #ifndef ENVIRONMENTMODELOBSTACLE_H_
 #define ENVIRONMENTMODELOBSTACLE_H_
 
-#include "artery/envmod/EnvironmentModelObject.h"
-#include "artery/utility/Geometry.h"
-#include <string>
-#include <vector>
+#include "artery/traci/StaticObstacles.h"
 
 namespace artery
 {
 
 /**
  * Representation of an obstacle inside the environment model
+ *
+ * Obstacles are static obstacles shared with other modules, e.g. GEMV2's obstacle index.
  */
-class EnvironmentModelObstacle
-{
-public:
-    EnvironmentModelObstacle(std::string id, std::vector<Position> outline) :
-        mId(id), mPolygon(outline) {}
-
-    /**
-     * Returns the obstacle id
-     * @return obstacle id
-     */
-    const std::string& getObstacleId() const { return mId; }
-
-    /**
-     * Returns the obstacle coords
-     * @return obstacle coords
-     */
-    const std::vector<Position>& getOutline() const { return mPolygon; }
-
-private:
-    std::string mId; //!< Unique obstacle id
-    std::vector<Position> mPolygon; //!< Obstacle outline
-};
-
+using EnvironmentModelObstacle = StaticObstacle;
 
 } // namespace artery
 
@@ -10,6 +10,7 @@
 #include "artery/envmod/sensor/SensorConfiguration.h"
 #include "artery/traci/Cast.h"
 #include "artery/traci/ControllableVehicle.h"
+#include "artery/utility/FigureRecycling.h"
 #include "artery/utility/IdentityRegistry.h"
 #include "traci/Core.h"
 #include <boost/geometry/geometries/register/linestring.hpp>
@@ -34,19 +35,27 @@ const simsignal_t traciNodeAddSignal = cComponent::registerSignal("traci.node.ad
 const simsignal_t traciNodeRemoveSignal = cComponent::registerSignal("traci.node.remove");
 const simsignal_t traciNodeUpdateSignal = cComponent::registerSignal("traci.node.update");
 
-template<typename RT>
-typename RT::const_query_iterator
-query_intersections(RT& rtree, const std::vector<Position>& area)
+template<typename G>
+auto intersects_predicate(const G& area) -> decltype(boost::geometry::index::intersects(area))
 {
+    return boost::geometry::index::intersects(area);
+}
+
 #if BOOST_VERSION >= 106000 && BOOST_VERSION < 106200
-    // Boost versions 1.60 and 1.61 do not compile without copy
+// Boost versions 1.60 and 1.61 do not compile without copy
+auto intersects_predicate(const std::vector<Position>& area) -> decltype(boost::geometry::index::intersects(geometry::Polygon()))
+{
     geometry::Polygon area_copy;
     boost::geometry::convert(area, area_copy);
-    auto predicate = boost::geometry::index::intersects(area_copy);
-#else
-    auto predicate = boost::geometry::index::intersects(area);
+    return boost::geometry::index::intersects(area_copy);
+}
 #endif
-    return rtree.qbegin(predicate);
+
+template<typename RT, typename G>
+typename RT::const_query_iterator
+query_intersections(const RT& rtree, const G& area)
+{
+    return rtree.qbegin(intersects_predicate(area));
 }
 
 } // namespace
@@ -68,47 +77,35 @@ void GlobalEnvironmentModel::refresh()
 
     buildObjectRtree();
 
-    if (mDrawVehicles) {
-        int numObjects = mObjects.size();
-        int numFigures = mDrawVehicles->getNumFigures();
+    mVehicleFiguresDirty = true;
 
-        // add missing polygon figures
-        while (numFigures < numObjects) {
-            auto polygon = new cPolygonFigure();
-            polygon->setFillColor(cFigure::BLUE);
-            polygon->setFilled(true);
-            mDrawVehicles->addFigure(polygon);
-            ++numFigures;
-        }
+    emit(refreshSignal, this);
+}
 
-        // remove excessive polygon figures
-        while (numFigures > numObjects) {
-            --numFigures;
-            delete mDrawVehicles->removeFigure(numFigures);
-        }
+void GlobalEnvironmentModel::refreshDisplay() const
+{
+    if (!mDrawVehicles || !mVehicleFiguresDirty) {
+        return;
+    }
 
-        // update figures with current outlines
-        int figureIndex = 0;
-        for (const auto& object_kv : mObjects) {
-            // we add only polygon figures, thus static_cast should be safe
-            auto polygon = static_cast<cPolygonFigure*>(mDrawVehicles->getFigure(figureIndex));
-            std::vector<cFigure::Point> points;
-            for (const Position& pos : object_kv.second->getOutline()) {
-                points.push_back(cFigure::Point { pos.x.value(), pos.y.value() });
-            }
-            polygon->setPoints(points);
-            ++figureIndex;
-        }
+    int figureIndex = 0;
+    for (const auto& object_kv : mObjects) {
+        auto polygon = figures::recycle<cPolygonFigure>(mDrawVehicles, figureIndex);
+        polygon->setFillColor(cFigure::BLUE);
+        polygon->setFilled(true);
+        figures::assignPoints(polygon, object_kv.second->getOutline());
+        ++figureIndex;
     }
+    figures::hideRemaining(mDrawVehicles, figureIndex);
 
-    emit(refreshSignal, this);
+    mVehicleFiguresDirty = false;
 }
 
 bool GlobalEnvironmentModel::addVehicle(traci::VehicleController* vehicle)
 {
     uint32_t id = 0;
     if (mIdentityRegistry) {
-        auto identity = mIdentityRegistry->lookup<IdentityRegistry::traci>(vehicle->getVehicleId());
+        auto identity = mIdentityRegistry->find<IdentityRegistry::traci>(vehicle->getVehicleId());
         if (identity) {
             id = identity->application;
         }
@@ -119,52 +116,14 @@ bool GlobalEnvironmentModel::addVehicle(traci::VehicleController* vehicle)
     if (insertion.second) {
         auto box = boost::geometry::return_envelope<geometry::Box>(object->getOutline());
         mObjectRtree.insert(ObjectRtreeValue { std::move(box), object });
-    }
-    ASSERT(mObjects.size() == mObjectRtree.size());
-    return insertion.second;
-}
-
-bool GlobalEnvironmentModel::addObstacle(const std::string& id, std::vector<Position> outline)
-{
-    boost::geometry::correct(outline);
-    std::string invalid;
-    if (!boost::geometry::is_valid(outline, invalid)) {
-        // skip self-intersecting geometry
-        EV_ERROR << "skip invalid obstacle polygon " << id << ": " << invalid << " \n";
-        return false;
-    }
-    auto insertion = mObstacles.emplace(id, std::make_shared<EnvironmentModelObstacle>(id, outline));
-
-    if (mDrawObstacles) {
-        auto polygon = new cPolygonFigure();
-        polygon->setFilled(true);
-        polygon->setFillColor(cFigure::BLACK);
-        polygon->setFillOpacity(0.7);
-        for (const Position& pos : outline) {
-            polygon->addPoint(cFigure::Point { pos.x.value(), pos.y.value() });
+        if (id != 0) {
+            mapStationId(insertion.first->first, id);
         }
-        mDrawObstacles->addFigure(polygon);
     }
-
+    ASSERT(mObjects.size() == mObjectRtree.size());
     return insertion.second;
 }
 
-void GlobalEnvironmentModel::buildObstacleRtree()
-{
-    struct envelope_maker
-    {
-        inline ObstacleRtreeValue operator()(const ObstacleDB::value_type& item) const
-        {
-            const auto& obstacle = item.second;
-            auto box = boost::geometry::return_envelope<geometry::Box>(obstacle->getOutline());
-            return ObstacleRtreeValue { std::move(box), obstacle };
-        }
-    };
-
-    // bulk loading of obstacles for efficient packing
-    mObstacleRtree = ObstacleRtree { mObstacles | boost::adaptors::transformed(envelope_maker()) };
-}
-
 void GlobalEnvironmentModel::buildObjectRtree()
 {
     struct envelope_maker
@@ -184,6 +143,7 @@ void GlobalEnvironmentModel::buildObjectRtree()
 
 bool GlobalEnvironmentModel::removeVehicle(const std::string& objectId)
 {
+    unmapStationId(objectId);
     bool erased = mObjects.erase(objectId) > 0;
     mTainted |= erased; /*< pending object rtree update */
     return erased;
@@ -191,23 +151,55 @@ bool GlobalEnvironmentModel::removeVehicle(const std::string& objectId)
 
 void GlobalEnvironmentModel::removeVehicles()
 {
+    mStationObjects.clear();
+    mObjectStations.clear();
     mObjects.clear();
     mObjectRtree.clear();
     mTainted = false;
 
-    if (mDrawVehicles) {
-        // remove all polygons
-        for (int i = mDrawVehicles->getNumFigures() - 1; i >= 0; --i) {
-            delete mDrawVehicles->removeFigure(i);
+    mVehicleFiguresDirty = true;
+}
+
+void GlobalEnvironmentModel::mapStationId(const std::string& objectId, uint32_t stationId)
+{
+    auto object = mObjects.find(objectId);
+    if (object == mObjects.end()) {
+        return;
+    }
+
+    auto previous = mObjectStations.find(objectId);
+    if (previous != mObjectStations.end()) {
+        if (previous->second == stationId) {
+            return;
+        }
+        auto mapped = mStationObjects.find(previous->second);
+        if (mapped != mStationObjects.end() && mapped->second == &object->second) {
+            mStationObjects.erase(mapped);
         }
+        previous->second = stationId;
+    } else {
+        mObjectStations.emplace(objectId, stationId);
+    }
+    mStationObjects[stationId] = &object->second;
+}
+
+void GlobalEnvironmentModel::unmapStationId(const std::string& objectId)
+{
+    auto station = mObjectStations.find(objectId);
+    if (station != mObjectStations.end()) {
+        auto mapped = mStationObjects.find(station->second);
+        auto object = mObjects.find(objectId);
+        if (mapped != mStationObjects.end() && object != mObjects.end() && mapped->second == &object->second) {
+            mStationObjects.erase(mapped);
+        }
+        mObjectStations.erase(station);
     }
 }
 
 void GlobalEnvironmentModel::clear()
 {
     removeVehicles();
-    mObstacles.clear();
-    mObstacleRtree.clear();
+    mObstacles = StaticObstacleView();
 }
 
 void GlobalEnvironmentModel::initialize()
@@ -227,22 +219,29 @@ void GlobalEnvironmentModel::initialize()
     mIdentityRegistry = inet::findModuleFromPar<IdentityRegistry>(par("identityRegistryModule"), this);
     mTainted = false;
 
-    if (par("drawObstacles")) {
+    // follow identity updates for station ID lookups
+    getSystemModule()->subscribe(IdentityRegistry::updateSignal, this);
+
+    // figures are only updated by refreshDisplay, i.e. skip them entirely without GUI
+    if (hasGUI() && par("drawObstacles")) {
         mDrawObstacles = new omnetpp::cGroupFigure("obstacles");
         getCanvas()->addFigure(mDrawObstacles);
     }
 
-    if (par("drawVehicles")) {
+    if (hasGUI() && par("drawVehicles")) {
         mDrawVehicles = new omnetpp::cGroupFigure("vehicles");
         getCanvas()->addFigure(mDrawVehicles);
     }
 
     std::string obstacleTypes = par("obstacleTypes");
-    boost::split(mObstacleTypes, obstacleTypes, boost::is_any_of(" "));
+    mObstacleFilter.types.clear();
+    boost::split(mObstacleFilter.types, obstacleTypes, boost::is_any_of(" "));
+    StaticObstacles::instance().announce(mObstacleFilter, ObstacleSnapshotFile::fromParameters(*this));
 }
 
 void GlobalEnvironmentModel::finish()
 {
+    getSystemModule()->unsubscribe(IdentityRegistry::updateSignal, this);
     removeVehicles();
 }
 
@@ -278,32 +277,33 @@ void GlobalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, unsi
     }
 }
 
-void GlobalEnvironmentModel::fetchObstacles(const traci::API& traci)
+void GlobalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, cObject* obj, cObject*)
 {
-    auto& polygons = traci.polygon;
-    const traci::Boundary boundary { traci.simulation.getNetBoundary() };
-    for (const std::string& id : polygons.getIDList()) {
-        if (!mObstacleTypes.empty()) {
-            std::string type = polygons.getType(id);
-            if (mObstacleTypes.find(type) == mObstacleTypes.end()) {
-                // skip polygon because its type is not in our filter set
-                EV_DEBUG << "ignore polygon " << id << " of type " << type << "\n";
-                continue;
-            }
-        }
-
-        std::vector<Position> shape;
-        for (const traci::TraCIPosition& traci_point : polygons.getShape(id).value) {
-            shape.push_back(traci::position_cast(boundary, traci_point));
-        }
-        if (shape.size() >= 3) {
-            addObstacle(id, shape);
-        } else {
-            EV_WARN << "skip obstacle polygon " << id << " because its shape is degraded\n";
+    if (signal == IdentityRegistry::updateSignal) {
+        auto identity = dynamic_cast<Identity*>(obj);
+        if (identity && identity->application != 0 && !identity->traci.empty()) {
+            mapStationId(identity->traci, identity->application);
         }
     }
+}
+
+void GlobalEnvironmentModel::fetchObstacles(const traci::API& traci)
+{
+    mObstacles = StaticObstacles::instance().getView(traci, mObstacleFilter);
+    EV_INFO << mObstacles.size() << " obstacles available to environment model\n";
 
-    buildObstacleRtree();
+    if (mDrawObstacles) {
+        mObstacles.forEach([this](const std::shared_ptr<EnvironmentModelObstacle>& obstacle) {
+            auto polygon = new cPolygonFigure();
+            polygon->setFilled(true);
+            polygon->setFillColor(cFigure::BLACK);
+            polygon->setFillOpacity(0.7);
+            for (const Position& pos : obstacle->getOutline()) {
+                polygon->addPoint(cFigure::Point { pos.x.value(), pos.y.value() });
+            }
+            mDrawObstacles->addFigure(polygon);
+        });
+    }
 }
 
 traci::VehicleController* GlobalEnvironmentModel::getVehicleController(cModule* module)
@@ -319,48 +319,97 @@ std::shared_ptr<EnvironmentModelObject> GlobalEnvironmentModel::getObject(const
     return found != mObjects.end() ? found->second : nullptr;
 }
 
+GlobalEnvironmentModel::ObjectHandle GlobalEnvironmentModel::getObjectByStationId(uint32_t stationId) const
+{
+    auto found = mStationObjects.find(stationId);
+    return found != mStationObjects.end() ? found->second : nullptr;
+}
+
 std::shared_ptr<EnvironmentModelObstacle> GlobalEnvironmentModel::getObstacle(const std::string& obsId)
 {
-    auto found = mObstacles.find(obsId);
-    return found != mObstacles.end() ? found->second : nullptr;
+    ObstacleHandle handle = mObstacles.find(obsId);
+    return handle ? *handle : nullptr;
 }
 
 std::vector<std::shared_ptr<EnvironmentModelObject>>
 GlobalEnvironmentModel::preselectObjects(const std::string& ego, const std::vector<Position>& area)
 {
-    ASSERT(!mTainted);
+    validateArea(area);
 
-    boost::geometry::validity_failure_type failure;
-    if (!boost::geometry::is_valid(area, failure)) {
-        std::string error_msg =  boost::geometry::validity_failure_type_message(failure);
-        throw omnetpp::cRuntimeError("preselection polygon is invalid: %s", error_msg.c_str());
-    }
+    std::vector<ObjectHandle> handles;
+    collectObjects(ego, area, handles);
 
     std::vector<std::shared_ptr<EnvironmentModelObject>> objectsInSearchArea;
+    objectsInSearchArea.reserve(handles.size());
+    for (ObjectHandle handle : handles) {
+        objectsInSearchArea.push_back(*handle);
+    }
+    return objectsInSearchArea;
+}
+
+void GlobalEnvironmentModel::preselectObjects(const std::string& ego, const geometry::Box& area,
+        std::vector<ObjectHandle>& objects) const
+{
+    collectObjects(ego, area, objects);
+}
+
+template<typename G>
+void GlobalEnvironmentModel::collectObjects(const std::string& ego, const G& area,
+        std::vector<ObjectHandle>& objects) const
+{
+    ASSERT(!mTainted);
+    objects.clear();
+
+    // compare object pointers instead of constructing an external id string for each candidate
+    auto egoFound = mObjects.find(ego);
+    const EnvironmentModelObject* egoObject = egoFound != mObjects.end() ? egoFound->second.get() : nullptr;
+
     ObjectRtree::const_query_iterator it = query_intersections(mObjectRtree, area);
     for (; it != mObjectRtree.qend(); ++it) {
-        if (it->second->getExternalId() != ego) {
-            objectsInSearchArea.push_back(it->second);
+        if (it->second.get() != egoObject) {
+            objects.push_back(&it->second);
         }
     }
-    return objectsInSearchArea;
 }
 
 std::vector<std::shared_ptr<EnvironmentModelObstacle>>
 GlobalEnvironmentModel::preselectObstacles(const std::vector<Position>& area)
+{
+    validateArea(area);
+
+    std::vector<ObstacleHandle> handles;
+    collectObstacles(area, handles);
+
+    std::vector<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
+    obstacles.reserve(handles.size());
+    for (ObstacleHandle handle : handles) {
+        obstacles.push_back(*handle);
+    }
+    return obstacles;
+}
+
+void GlobalEnvironmentModel::preselectObstacles(const geometry::Box& area, std::vector<ObstacleHandle>& obstacles) const
+{
+    collectObstacles(area, obstacles);
+}
+
+template<typename G>
+void GlobalEnvironmentModel::collectObstacles(const G& area, std::vector<ObstacleHandle>& obstacles) const
+{
+    obstacles.clear();
+    mObstacles.query(intersects_predicate(area), [&obstacles](const std::shared_ptr<EnvironmentModelObstacle>& obstacle) {
+        obstacles.push_back(&obstacle);
+        return true;
+    });
+}
+
+void GlobalEnvironmentModel::validateArea(const std::vector<Position>& area)
 {
     boost::geometry::validity_failure_type failure;
     if (!boost::geometry::is_valid(area, failure)) {
         std::string error_msg =  boost::geometry::validity_failure_type_message(failure);
         throw omnetpp::cRuntimeError("preselection polygon is invalid: %s", error_msg.c_str());
     }
-
-    std::vector<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
-    ObstacleRtree::const_query_iterator it = query_intersections(mObstacleRtree, area);
-    for (; it != mObstacleRtree.qend(); ++it) {
-        obstacles.push_back(it->second);
-    }
-    return obstacles;
 }
 
 } // namespace artery
@@ -16,6 +16,7 @@
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <boost/geometry/index/rtree.hpp>
+#include <cstdint>
 #include <unordered_map>
 #include <memory>
 #include <string>
@@ -29,7 +30,6 @@ namespace traci {
 namespace artery
 {
 
-class EnvironmentModelObstacle;
 class IdentityRegistry;
 
 /**
@@ -44,11 +44,13 @@ public:
     // cSimpleModule life-cycle
     void initialize() override;
     void finish() override;
+    void refreshDisplay() const override;
 
     // cListener handlers
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const omnetpp::SimTime&, omnetpp::cObject*) override;
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, const char*, omnetpp::cObject*) override;
     void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, unsigned long, omnetpp::cObject*) override;
+    void receiveSignal(omnetpp::cComponent*, omnetpp::simsignal_t, omnetpp::cObject*, omnetpp::cObject*) override;
 
     /**
      * Fetch an object by its external id.
@@ -64,6 +66,25 @@ public:
      */
     std::shared_ptr<EnvironmentModelObstacle> getObstacle(const std::string& obsId);
 
+    /**
+     * Non-owning handles to objects and obstacles of this model
+     *
+     * Handles refer to the model's own shared pointers, i.e. they can be dereferenced
+     * without touching reference counts. Object handles become invalid with the next
+     * refresh of the model, obstacle handles stay valid until the TraCI connection is closed.
+     */
+    using ObjectHandle = const std::shared_ptr<EnvironmentModelObject>*;
+    using ObstacleHandle = const std::shared_ptr<EnvironmentModelObstacle>*;
+
+    /**
+     * Fetch an object by the station ID of its identity
+     *
+     * Station IDs are tracked via identity updates, i.e. they follow station ID changes.
+     * @param stationId ETSI station ID
+     * @return handle to object or nullptr, valid until the object is removed
+     */
+    ObjectHandle getObjectByStationId(uint32_t stationId) const;
+
     /**
      * Preselect all objects close to the given area
      * @param ego identifier of the ego object, which is filtered out of the result
@@ -73,6 +94,18 @@ public:
     std::vector<std::shared_ptr<EnvironmentModelObject>>
     preselectObjects(const std::string& ego, const std::vector<Position>& area);
 
+    /**
+     * Preselect all objects whose bounding boxes intersect the given box into a reusable buffer
+     *
+     * Box queries are cheaper than polygon queries but yield more candidates,
+     * i.e. callers need to check candidates against their precise search area.
+     *
+     * @param ego identifier of the ego object, which is filtered out of the result
+     * @param area search box, e.g. bounding box of a sensor cone
+     * @param objects buffer receiving preselected objects, previous content is discarded
+     */
+    void preselectObjects(const std::string& ego, const geometry::Box& area, std::vector<ObjectHandle>& objects) const;
+
     /**
      * Preselect all obstacles close to the given area
      * @param area search polygon
@@ -81,7 +114,27 @@ public:
     std::vector<std::shared_ptr<EnvironmentModelObstacle>>
     preselectObstacles(const std::vector<Position>& area);
 
+    /**
+     * Preselect all obstacles whose bounding boxes intersect the given box into a reusable buffer
+     * @param area search box
+     * @param obstacles buffer receiving preselected obstacles, previous content is discarded
+     */
+    void preselectObstacles(const geometry::Box& area, std::vector<ObstacleHandle>& obstacles) const;
+
+    /**
+     * Check if area is a valid search polygon
+     * @param area search polygon
+     * @throw omnetpp::cRuntimeError if polygon is invalid
+     */
+    static void validateArea(const std::vector<Position>& area);
+
 private:
+    template<typename G>
+    void collectObjects(const std::string& ego, const G& area, std::vector<ObjectHandle>& objects) const;
+
+    template<typename G>
+    void collectObstacles(const G& area, std::vector<ObstacleHandle>& obstacles) const;
+
     /**
      * Refresh all dynamic objects in the database.
      */
@@ -102,23 +155,22 @@ private:
     bool removeVehicle(const std::string& nodeId);
 
     /**
-     * Remove all known vehicles from internal database
+     * Associate station ID with an object, replacing its previous association
+     * @param objectId external id of object
+     * @param stationId station ID of object's identity
      */
-    void removeVehicles();
+    void mapStationId(const std::string& objectId, uint32_t stationId);
 
     /**
-     * Add (static) obstacles to the obstacle database
-     * @param id Obstacle's id
-     * @param outline Obstacle's outline
-     * @return true if it could be added
+     * Remove station ID association of an object
+     * @param objectId external id of object
      */
-    bool addObstacle(const std::string& id, std::vector<Position> outline);
+    void unmapStationId(const std::string& objectId);
 
     /**
-     * Create the obstacle rtree.
-     * This method should be called after all static obstacles have been added.
+     * Remove all known vehicles from internal database
      */
-    void buildObstacleRtree();
+    void removeVehicles();
 
     /**
      * Create the object rtree.
@@ -131,7 +183,7 @@ private:
     void clear();
 
     /**
-     * Fetch static obstacles (polygons) from TraCI
+     * Fetch view on static obstacles (polygons) shared with other modules
      * @param api TraCI API object
      */
     void fetchObstacles(const traci::API& api);
@@ -146,19 +198,18 @@ private:
     using ObjectDB = std::unordered_map<std::string, std::shared_ptr<EnvironmentModelObject>>;
     using ObjectRtreeValue = std::pair<geometry::Box, std::shared_ptr<EnvironmentModelObject>>;
     using ObjectRtree = boost::geometry::index::rtree<ObjectRtreeValue, boost::geometry::index::quadratic<16>>;
-    using ObstacleDB = std::unordered_map<std::string, std::shared_ptr<EnvironmentModelObstacle>>;
-    using ObstacleRtreeValue = std::pair<geometry::Box, std::shared_ptr<EnvironmentModelObstacle>>;
-    using ObstacleRtree = boost::geometry::index::rtree<ObstacleRtreeValue, boost::geometry::index::rstar<16>>;
 
     ObjectDB mObjects;
     ObjectRtree mObjectRtree;
-    ObstacleDB mObstacles;
-    ObstacleRtree mObstacleRtree;
+    std::unordered_map<uint32_t, ObjectHandle> mStationObjects; /*< station ID -> object */
+    std::unordered_map<std::string, uint32_t> mObjectStations; /*< external id -> station ID */
+    StaticObstacleView mObstacles;
     IdentityRegistry* mIdentityRegistry;
     bool mTainted = false;
     omnetpp::cGroupFigure* mDrawObstacles = nullptr;
     omnetpp::cGroupFigure* mDrawVehicles = nullptr;
-    std::set<std::string> mObstacleTypes;
+    mutable bool mVehicleFiguresDirty = false;
+    ObstacleFilter mObstacleFilter;
 };
 
 } // namespace artery
@@ -12,6 +12,8 @@
 #include "artery/utility/FilterRules.h"
 #include <inet/common/ModuleAccess.h>
 #include <omnetpp/cxmlelement.h>
+#include <algorithm>
+#include <iterator>
 #include <utility>
 
 using namespace omnetpp;
@@ -67,30 +69,20 @@ void LocalEnvironmentModel::receiveSignal(cComponent*, simsignal_t signal, cObje
 
 void LocalEnvironmentModel::complementObjects(const SensorDetection& detection, const Sensor& sensor)
 {
-   for (auto& detectedObject : detection.objects) {
-      auto foundObject = mObjects.find(detectedObject);
-      if (foundObject != mObjects.end()) {
-         Tracking& tracking = foundObject->second;
-         tracking.tap(&sensor);
-      } else {
-         mObjects.emplace(detectedObject, Tracking { ++mTrackingCounter, &sensor });
-      }
-   }
+    auto found = std::find(mSensors.begin(), mSensors.end(), &sensor);
+    if (found == mSensors.end()) {
+        throw cRuntimeError("sensor %s is not attached to this local environment model", sensor.getSensorName().c_str());
+    }
+
+    const std::size_t index = std::distance(mSensors.begin(), found);
+    for (auto& detectedObject : detection.objects) {
+        mObjects.tap(detectedObject, index, mTrackingCounter);
+    }
 }
 
 void LocalEnvironmentModel::update()
 {
-    for (auto it = mObjects.begin(); it != mObjects.end();) {
-        const Object& object = it->first;
-        Tracking& tracking = it->second;
-        tracking.update();
-
-        if (object.expired() || tracking.expired()) {
-            it = mObjects.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    mObjects.expire(simTime());
 }
 
 void LocalEnvironmentModel::initializeSensors()
@@ -130,43 +122,256 @@ void LocalEnvironmentModel::initializeSensors()
             mSensors.push_back(sensor);
         }
     }
+
+    if (mSensors.size() > MaxSensors) {
+        throw cRuntimeError("at most %zu sensors are supported by local environment model", MaxSensors);
+    }
+    mObjects.setSensors(mSensors);
 }
 
 
-LocalEnvironmentModel::Tracking::Tracking(int id, const Sensor* sensor) : mId(id)
+constexpr std::size_t LocalEnvironmentModel::MaxSensors;
+constexpr std::int32_t LocalEnvironmentModel::TrackedObjects::EmptySlot;
+
+void LocalEnvironmentModel::TrackedObjects::setSensors(const std::vector<Sensor*>& sensors)
 {
-    mSensors.emplace(sensor, TrackingTime {});
+    clear();
+    mSensors.assign(sensors.begin(), sensors.end());
+    mValidity.clear();
+    for (const Sensor* sensor : mSensors) {
+        mValidity.push_back(sensor->getValidityPeriod());
+    }
 }
 
-bool LocalEnvironmentModel::Tracking::expired() const
+void LocalEnvironmentModel::TrackedObjects::clear()
 {
-    return mSensors.empty();
+    mEntries.clear();
+    mTimes.clear();
+    mSlots.clear();
 }
 
-void LocalEnvironmentModel::Tracking::update()
+std::size_t LocalEnvironmentModel::TrackedObjects::home(const EnvironmentModelObject* key) const
 {
-    for (auto it = mSensors.begin(); it != mSensors.end();) {
-      const Sensor* sensor = it->first;
-      const TrackingTime& tracking = it->second;
+    // Fibonacci hashing of object address: high bits of product select one of 2^(64 - shift) slots
+    const std::uint64_t address = reinterpret_cast<std::uintptr_t>(key);
+    return static_cast<std::size_t>((address * 0x9E3779B97F4A7C15ull) >> mSlotShift);
+}
 
-      const bool expired = tracking.last() + sensor->getValidityPeriod() < simTime();
-      if (expired) {
-          it = mSensors.erase(it);
-      } else {
-          ++it;
-      }
+std::size_t LocalEnvironmentModel::TrackedObjects::slot(const EnvironmentModelObject* key) const
+{
+    const std::size_t mask = mSlots.size() - 1;
+    std::size_t index = home(key);
+    while (mSlots[index] != EmptySlot && mEntries[mSlots[index]].key != key) {
+        index = (index + 1) & mask;
     }
+    return index;
 }
 
-void LocalEnvironmentModel::Tracking::tap(const Sensor* sensor)
+void LocalEnvironmentModel::TrackedObjects::insert(std::size_t row)
 {
-    auto found = mSensors.find(sensor);
-    if (found != mSensors.end()) {
-         TrackingTime& tracking = found->second;
-         tracking.tap();
+    mSlots[slot(mEntries[row].key)] = row;
+}
+
+void LocalEnvironmentModel::TrackedObjects::erase(std::size_t index)
+{
+    // backward shift deletion keeps probe sequences of linear probing intact without tombstones
+    const std::size_t mask = mSlots.size() - 1;
+    std::size_t hole = index;
+    for (std::size_t next = (hole + 1) & mask; mSlots[next] != EmptySlot; next = (next + 1) & mask) {
+        const std::size_t probes = (next - home(mEntries[mSlots[next]].key)) & mask;
+        if (probes >= ((next - hole) & mask)) {
+            mSlots[hole] = mSlots[next];
+            hole = next;
+        }
+    }
+    mSlots[hole] = EmptySlot;
+}
+
+void LocalEnvironmentModel::TrackedObjects::rebuildIndex(std::size_t slots)
+{
+    // slot count is a power of two
+    mSlots.assign(slots, EmptySlot);
+    mSlotShift = 64 - __builtin_ctzll(slots);
+    for (std::size_t row = 0; row < mEntries.size(); ++row) {
+        insert(row);
+    }
+}
+
+void LocalEnvironmentModel::TrackedObjects::tap(const std::shared_ptr<EnvironmentModelObject>& object, std::size_t sensor, int& counter)
+{
+    const SensorMask bit = SensorMask(1) << sensor;
+    const std::size_t columns = mSensors.size();
+
+    if (!mSlots.empty()) {
+        const std::int32_t row = mSlots[slot(object.get())];
+        if (row != EmptySlot) {
+            Entry& entry = mEntries[row];
+            if (entry.object.expired()) {
+                // object address has been recycled since last update
+                entry.object = object;
+                entry.id = ++counter;
+                entry.sensors = 0;
+            }
+
+            TrackingTime& time = mTimes[row * columns + sensor];
+            if (entry.sensors & bit) {
+                time.tap();
+            } else {
+                time = TrackingTime {};
+                entry.sensors |= bit;
+            }
+            return;
+        }
+    }
+
+    mEntries.push_back(Entry { object, object.get(), ++counter, bit });
+    mTimes.resize(mEntries.size() * columns);
+    mTimes[(mEntries.size() - 1) * columns + sensor] = TrackingTime {};
+
+    // keep load factor of open addressing index at most 50%
+    if (mEntries.size() * 2 > mSlots.size()) {
+        rebuildIndex(std::max<std::size_t>(16, mSlots.size() * 2));
     } else {
-         mSensors.emplace(sensor, TrackingTime {});
+        insert(mEntries.size() - 1);
+    }
+}
+
+void LocalEnvironmentModel::TrackedObjects::expire(SimTime now)
+{
+    const std::size_t columns = mSensors.size();
+    bool expired = false;
+    for (std::size_t row = 0; row < mEntries.size(); ++row) {
+        Entry& entry = mEntries[row];
+        for (SensorMask pending = entry.sensors; pending; pending &= pending - 1) {
+            const std::size_t sensor = __builtin_ctzll(pending);
+            if (mTimes[row * columns + sensor].last() + mValidity[sensor] < now) {
+                entry.sensors &= ~(SensorMask(1) << sensor);
+            }
+        }
+
+        if (entry.sensors == 0 || entry.object.expired()) {
+            // remove expired entries from index while all rows are still in place
+            erase(slot(entry.key));
+            entry.key = nullptr;
+            expired = true;
+        }
+    }
+
+    if (!expired) {
+        return;
     }
+
+    // compact rows in insertion order, index follows each moved row
+    std::size_t kept = 0;
+    for (std::size_t row = 0; row < mEntries.size(); ++row) {
+        if (!mEntries[row].key) {
+            continue;
+        } else if (kept != row) {
+            mSlots[slot(mEntries[row].key)] = kept;
+            mEntries[kept] = std::move(mEntries[row]);
+            std::copy_n(mTimes.begin() + row * columns, columns, mTimes.begin() + kept * columns);
+        }
+        ++kept;
+    }
+    mEntries.erase(mEntries.begin() + kept, mEntries.end());
+    mTimes.resize(kept * columns);
+}
+
+const LocalEnvironmentModel::TrackingTime& LocalEnvironmentModel::TrackedObjects::time(std::size_t row, std::size_t sensor) const
+{
+    return mTimes[row * mSensors.size() + sensor];
+}
+
+LocalEnvironmentModel::SensorMask LocalEnvironmentModel::TrackedObjects::maskByCategory(const std::string& category) const
+{
+    SensorMask mask = 0;
+    for (std::size_t i = 0; i < mSensors.size(); ++i) {
+        if (mSensors[i]->getSensorCategory() == category) {
+            mask |= SensorMask(1) << i;
+        }
+    }
+    return mask;
+}
+
+LocalEnvironmentModel::SensorMask LocalEnvironmentModel::TrackedObjects::maskByName(const std::string& name) const
+{
+    SensorMask mask = 0;
+    for (std::size_t i = 0; i < mSensors.size(); ++i) {
+        if (mSensors[i]->getSensorName() == name) {
+            mask |= SensorMask(1) << i;
+        }
+    }
+    return mask;
+}
+
+LocalEnvironmentModel::TrackedObjects::const_iterator::const_iterator(const TrackedObjects* table, std::size_t row) :
+    mTable(table), mRow(row)
+{
+}
+
+LocalEnvironmentModel::TrackedObject LocalEnvironmentModel::TrackedObjects::const_iterator::dereference() const
+{
+    return TrackedObject { mTable->mEntries[mRow].object, Tracking { *mTable, mRow } };
+}
+
+bool LocalEnvironmentModel::TrackedObjects::const_iterator::equal(const const_iterator& other) const
+{
+    return mTable == other.mTable && mRow == other.mRow;
+}
+
+std::ptrdiff_t LocalEnvironmentModel::TrackedObjects::const_iterator::distance_to(const const_iterator& other) const
+{
+    return static_cast<std::ptrdiff_t>(other.mRow) - static_cast<std::ptrdiff_t>(mRow);
+}
+
+
+LocalEnvironmentModel::Tracking::Tracking(const TrackedObjects& table, std::size_t row) :
+    mTable(&table), mRow(row)
+{
+}
+
+bool LocalEnvironmentModel::Tracking::expired() const
+{
+    return sensorMask() == 0;
+}
+
+int LocalEnvironmentModel::Tracking::id() const
+{
+    return mTable->mEntries[mRow].id;
+}
+
+LocalEnvironmentModel::SensorMask LocalEnvironmentModel::Tracking::sensorMask() const
+{
+    return mTable->mEntries[mRow].sensors;
+}
+
+LocalEnvironmentModel::Tracking::SensorRange LocalEnvironmentModel::Tracking::sensors() const
+{
+    return SensorRange {
+        SensorIterator { mTable, mRow, sensorMask() },
+        SensorIterator { mTable, mRow, 0 }
+    };
+}
+
+LocalEnvironmentModel::Tracking::SensorIterator::SensorIterator(const TrackedObjects* table, std::size_t row, SensorMask pending) :
+    mTable(table), mRow(row), mPending(pending)
+{
+}
+
+LocalEnvironmentModel::Tracking::SensorTracking LocalEnvironmentModel::Tracking::SensorIterator::dereference() const
+{
+    const std::size_t sensor = __builtin_ctzll(mPending);
+    return SensorTracking { mTable->mSensors[sensor], mTable->time(mRow, sensor) };
+}
+
+bool LocalEnvironmentModel::Tracking::SensorIterator::equal(const SensorIterator& other) const
+{
+    return mPending == other.mPending;
+}
+
+void LocalEnvironmentModel::Tracking::SensorIterator::increment()
+{
+    mPending &= mPending - 1;
 }
 
 
@@ -183,16 +388,7 @@ void LocalEnvironmentModel::TrackingTime::tap()
 
 TrackedObjectsFilterRange filterBySensorCategory(const LocalEnvironmentModel::TrackedObjects& all, const std::string& category)
 {
-    // capture `category` by value because lambda expression will be evaluated after this function's return
-    TrackedObjectsFilterPredicate seenByCategory = [category](const LocalEnvironmentModel::TrackedObject& obj) {
-        const auto& detections = obj.second.sensors();
-        return std::any_of(detections.begin(), detections.end(),
-                [&category](const LocalEnvironmentModel::Tracking::TrackingMap::value_type& tracking) {
-                    const Sensor* sensor = tracking.first;
-                    return sensor->getSensorCategory() == category;
-                });
-    };
-
+    TrackedObjectsFilterPredicate seenByCategory { all.maskByCategory(category) };
     auto begin = boost::make_filter_iterator(seenByCategory, all.begin(), all.end());
     auto end = boost::make_filter_iterator(seenByCategory, all.end(), all.end());
     return boost::make_iterator_range(begin, end);
@@ -200,16 +396,7 @@ TrackedObjectsFilterRange filterBySensorCategory(const LocalEnvironmentModel::Tr
 
 TrackedObjectsFilterRange filterBySensorName(const LocalEnvironmentModel::TrackedObjects& all, const std::string& name)
 {
-    // capture `category` by value because lambda expression will be evaluated after this function's return
-    TrackedObjectsFilterPredicate seenByName = [name](const LocalEnvironmentModel::TrackedObject& obj) {
-        const auto& detections = obj.second.sensors();
-        return std::any_of(detections.begin(), detections.end(),
-                [&name](const LocalEnvironmentModel::Tracking::TrackingMap::value_type& tracking) {
-                    const Sensor* sensor = tracking.first;
-                    return sensor->getSensorName() == name;
-                });
-    };
-
+    TrackedObjectsFilterPredicate seenByName { all.maskByName(name) };
     auto begin = boost::make_filter_iterator(seenByName, all.begin(), all.end());
     auto end = boost::make_filter_iterator(seenByName, all.end(), all.end());
     return boost::make_iterator_range(begin, end);
@@ -8,13 +8,15 @@
 #define LOCALENVIRONMENTMODEL_H_
 
 #include <boost/iterator/filter_iterator.hpp>
+#include <boost/iterator/iterator_facade.hpp>
 #include <boost/range/iterator_range.hpp>
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <omnetpp/simtime.h>
-#include <functional>
-#include <map>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <utility>
 #include <vector>
 
 namespace artery
@@ -51,28 +53,135 @@ public:
         omnetpp::SimTime mLast;
     };
 
+    class TrackedObjects;
+
+    /**
+     * Bit set of sensors, bit positions correspond to indices of getSensors()
+     */
+    using SensorMask = std::uint64_t;
+    static constexpr std::size_t MaxSensors = 64;
+
+    /**
+     * Tracking state of a single object
+     *
+     * Tracking is a light-weight view into TrackedObjects' storage.
+     * It is only valid until the tracked objects are modified next time.
+     */
     class Tracking
     {
     public:
-        using TrackingMap = std::map<const Sensor*, TrackingTime>;
+        using SensorTracking = std::pair<const Sensor*, TrackingTime>;
 
-        Tracking(int id, const Sensor* sensor);
+        class SensorIterator : public boost::iterator_facade<
+            SensorIterator, SensorTracking, boost::forward_traversal_tag, SensorTracking>
+        {
+        public:
+            SensorIterator() = default;
+            SensorIterator(const TrackedObjects*, std::size_t row, SensorMask pending);
 
-        bool expired() const;
-        void update();
-        void tap(const Sensor*);
+        private:
+            friend class boost::iterator_core_access;
+            SensorTracking dereference() const;
+            bool equal(const SensorIterator&) const;
+            void increment();
+
+            const TrackedObjects* mTable = nullptr;
+            std::size_t mRow = 0;
+            SensorMask mPending = 0;
+        };
+
+        using SensorRange = boost::iterator_range<SensorIterator>;
 
-        int id() const { return mId; }
-        const TrackingMap& sensors() const { return mSensors; }
+        Tracking(const TrackedObjects&, std::size_t row);
+
+        bool expired() const;
+        int id() const;
+        SensorMask sensorMask() const;
+        SensorRange sensors() const;
 
     private:
-        int mId;
-        TrackingMap mSensors;
+        const TrackedObjects* mTable;
+        std::size_t mRow;
     };
 
-    using TrackedObjects = std::map<Object, Tracking, std::owner_less<Object>>;
-    using TrackedObject = typename TrackedObjects::value_type;
+    using TrackedObject = std::pair<const Object&, Tracking>;
+
+    /**
+     * Flat table of tracked objects
+     *
+     * Objects are stored contiguously in insertion order and looked up by an
+     * open addressing index.  Tracking times are kept in one row per object
+     * with a column per local sensor, i.e. sensors are addressed by index
+     * instead of associative containers.
+     */
+    class TrackedObjects
+    {
+    public:
+        class const_iterator : public boost::iterator_facade<
+            const_iterator, TrackedObject, boost::random_access_traversal_tag, TrackedObject>
+        {
+        public:
+            const_iterator() = default;
+            const_iterator(const TrackedObjects*, std::size_t row);
+
+        private:
+            friend class boost::iterator_core_access;
+            TrackedObject dereference() const;
+            bool equal(const const_iterator&) const;
+            void increment() { ++mRow; }
+            void decrement() { --mRow; }
+            void advance(std::ptrdiff_t n) { mRow += n; }
+            std::ptrdiff_t distance_to(const const_iterator& other) const;
+
+            const TrackedObjects* mTable = nullptr;
+            std::size_t mRow = 0;
+        };
 
+        const_iterator begin() const { return const_iterator(this, 0); }
+        const_iterator end() const { return const_iterator(this, mEntries.size()); }
+        std::size_t size() const { return mEntries.size(); }
+        bool empty() const { return mEntries.empty(); }
+
+        /**
+         * Get sensors whose category respectively name matches
+         */
+        SensorMask maskByCategory(const std::string&) const;
+        SensorMask maskByName(const std::string&) const;
+
+    private:
+        friend class LocalEnvironmentModel;
+        friend class Tracking;
+        friend class Tracking::SensorIterator;
+
+        struct Entry
+        {
+            Object object;
+            const EnvironmentModelObject* key;
+            int id;
+            SensorMask sensors;
+        };
+
+        static constexpr std::int32_t EmptySlot = -1;
+
+        void setSensors(const std::vector<Sensor*>&);
+        void tap(const std::shared_ptr<EnvironmentModelObject>&, std::size_t sensor, int& counter);
+        void expire(omnetpp::SimTime now);
+        void clear();
+
+        std::size_t home(const EnvironmentModelObject*) const;
+        std::size_t slot(const EnvironmentModelObject*) const;
+        void insert(std::size_t row);
+        void erase(std::size_t slot);
+        void rebuildIndex(std::size_t slots);
+        const TrackingTime& time(std::size_t row, std::size_t sensor) const;
+
+        std::vector<Entry> mEntries;
+        std::vector<TrackingTime> mTimes;
+        std::vector<std::int32_t> mSlots;
+        unsigned mSlotShift = 0; /*< 64 - log2 of slot count */
+        std::vector<const Sensor*> mSensors;
+        std::vector<omnetpp::SimTime> mValidity;
+    };
 
     LocalEnvironmentModel();
     virtual ~LocalEnvironmentModel() = default;
@@ -119,7 +228,23 @@ private:
     std::vector<Sensor*> mSensors;
 };
 
-using TrackedObjectsFilterPredicate = std::function<bool(const LocalEnvironmentModel::TrackedObject&)>;
+/**
+ * Matches objects tracked by any of the sensors in the given mask
+ */
+class TrackedObjectsFilterPredicate
+{
+public:
+    explicit TrackedObjectsFilterPredicate(LocalEnvironmentModel::SensorMask mask = 0) : mMask(mask) {}
+
+    bool operator()(const LocalEnvironmentModel::TrackedObject& obj) const
+    {
+        return (obj.second.sensorMask() & mMask) != 0;
+    }
+
+private:
+    LocalEnvironmentModel::SensorMask mMask;
+};
+
 using TrackedObjectsFilterIterator = boost::filter_iterator<TrackedObjectsFilterPredicate, LocalEnvironmentModel::TrackedObjects::const_iterator>;
 using TrackedObjectsFilterRange = boost::iterator_range<TrackedObjectsFilterIterator>;
 
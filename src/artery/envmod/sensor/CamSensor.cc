@@ -9,8 +9,6 @@
 #include "artery/envmod/LocalEnvironmentModel.h"
 #include "artery/application/CaObject.h"
 #include "artery/application/Middleware.h"
-#include "artery/utility/IdentityRegistry.h"
-#include <inet/common/ModuleAccess.h>
 
 using namespace omnetpp;
 
@@ -25,7 +23,6 @@ void CamSensor::initialize()
 {
     mValidityPeriod = par("validityPeriod");
     BaseSensor::initialize();
-    mIdentityRegistry = inet::getModuleFromPar<IdentityRegistry>(par("identityRegistryModule"), this);
     getMiddleware().subscribe(CamReceivedSignal, this);
 }
 
@@ -46,14 +43,14 @@ void CamSensor::receiveSignal(cComponent*, simsignal_t signal, cObject *obj, cOb
         auto* cam = dynamic_cast<CaObject*>(obj);
         if (cam) {
             uint32_t stationID = cam->asn1()->header.stationID;
-            auto identity = mIdentityRegistry->lookup<IdentityRegistry::application>(stationID);
-            if (identity) {
-                auto object = mGlobalEnvironmentModel->getObject(identity->traci);
-                SensorDetection detection;
-                detection.objects.push_back(object);
-                mLocalEnvironmentModel->complementObjects(detection, *this);
+            auto object = mGlobalEnvironmentModel->getObjectByStationId(stationID);
+            if (object) {
+                mDetection.clear();
+                mDetection.objects.push_back(*object);
+                mLocalEnvironmentModel->complementObjects(mDetection, *this);
+                mDetection.clear();
             } else {
-                EV_WARN << "Unknown identity for station ID " << stationID;
+                EV_WARN << "Unknown object for station ID " << stationID;
             }
         } else {
             EV_ERROR << "received signal has no CaObject";
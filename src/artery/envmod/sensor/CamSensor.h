@@ -14,8 +14,6 @@
 namespace artery
 {
 
-class IdentityRegistry;
-
 class CamSensor : public BaseSensor, public omnetpp::cListener
 {
 public:
@@ -33,9 +31,9 @@ protected:
     void finish() override;
 
 private:
-    IdentityRegistry* mIdentityRegistry;
     omnetpp::SimTime mValidityPeriod;
     std::string mSensorName;
+    SensorDetection mDetection; /*< reused for each received CAM */
 };
 
 } // namespace artery
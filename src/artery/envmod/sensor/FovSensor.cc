@@ -10,8 +10,9 @@
 #include "artery/envmod/sensor/SensorDetection.h"
 #include "artery/envmod/LocalEnvironmentModel.h"
 #include "artery/envmod/EnvironmentModelObstacle.h"
+#include "artery/utility/FigureRecycling.h"
 #include <boost/geometry/geometries/register/linestring.hpp>
-#include <unordered_set>
+#include <algorithm>
 
 using namespace omnetpp;
 
@@ -22,7 +23,7 @@ namespace artery
 {
 
 FovSensor::FovSensor() :
-    mGroupFigure(nullptr), mSensorConeFigure(nullptr), mLinesOfSightFigure(nullptr),
+    mSensorConeValidated(false), mGroupFigure(nullptr), mSensorConeFigure(nullptr), mLinesOfSightFigure(nullptr),
     mObjectsFigure(nullptr), mObstaclesFigure(nullptr)
 {
 }
@@ -47,8 +48,10 @@ void FovSensor::initialize()
         groupName += host->getName();
     }
     groupName += "-" + getSensorName();
-    mGroupFigure = new cGroupFigure(groupName.c_str());
-    mGlobalEnvironmentModel->getCanvas()->addFigure(mGroupFigure);
+    if (hasGUI()) {
+        mGroupFigure = new cGroupFigure(groupName.c_str());
+        mGlobalEnvironmentModel->getCanvas()->addFigure(mGroupFigure);
+    }
     mColor = cFigure::GOOD_DARK_COLORS[getId() % cFigure::NUM_GOOD_DARK_COLORS];
 
     mFovConfig.egoID = getEgoId();
@@ -59,6 +62,7 @@ void FovSensor::initialize()
     mFovConfig.fieldOfView.angle = par("fovAngle").doubleValue() * boost::units::degree::degrees;
     mFovConfig.numSegments = par("numSegments");
     mFovConfig.doLineOfSightCheck = par("doLineOfSightCheck");
+    mSensorCone = SensorCone(mFovConfig);
 
     initializeVisualization();
 }
@@ -66,34 +70,54 @@ void FovSensor::initialize()
 void FovSensor::measurement()
 {
     Enter_Method("measurement");
-    auto detection = detectObjects();
-    mLocalEnvironmentModel->complementObjects(detection, *this);
-    mLastDetection = std::move(detection);
+    detectObjects(mDetection);
+    mLocalEnvironmentModel->complementObjects(mDetection, *this);
+    // previous detection becomes the scratch buffer of the next measurement
+    mLastDetection.swap(mDetection);
+    mDetection.clear();
 }
 
 SensorDetection FovSensor::detectObjects() const
+{
+    SensorDetection detection;
+    detectObjects(detection);
+    return detection;
+}
+
+void FovSensor::detectObjects(SensorDetection& detection) const
 {
     namespace bg = boost::geometry;
+    using ObjectHandle = GlobalEnvironmentModel::ObjectHandle;
+    using ObstacleHandle = GlobalEnvironmentModel::ObstacleHandle;
     if (mFovConfig.fieldOfView.range <= 0.0 * boost::units::si::meter) {
         throw std::runtime_error("sensor range is 0 meter or less");
     } else if (mFovConfig.fieldOfView.angle > 360.0 * boost::units::degree::degrees) {
         throw std::runtime_error("sensor opening angle exceeds 360 degree");
     }
 
-    SensorDetection detection = createSensorCone();
-    auto preselObjectsInSensorRange = mGlobalEnvironmentModel->preselectObjects(mFovConfig.egoID, detection.sensorCone);
+    detection.clear();
+    createSensorCone(detection);
 
-    // get obstacles intersecting with sensor cone
-    auto obstacleIntersections = mGlobalEnvironmentModel->preselectObstacles(detection.sensorCone);
+    if (!mSensorConeValidated) {
+        // cones of a sensor differ only by translation and rotation, i.e. their validity does not change
+        GlobalEnvironmentModel::validateArea(detection.sensorCone);
+        mSensorConeValidated = true;
+    }
+
+    // preselection by bounding box, precise checks against the cone polygon follow
+    mGlobalEnvironmentModel->preselectObjects(mFovConfig.egoID, detection.sensorConeBounds, mPreselectedObjects);
+
+    // get obstacles close to sensor cone
+    mGlobalEnvironmentModel->preselectObstacles(detection.sensorConeBounds, mPreselectedObstacles);
 
     if (mFovConfig.doLineOfSightCheck)
     {
-        std::unordered_set<std::shared_ptr<EnvironmentModelObstacle>> blockingObstacles;
+        mBlockingObstacles.clear();
 
         // check if objects in sensor cone are hidden by another object or an obstacle
-        for (const auto& object : preselObjectsInSensorRange)
+        for (ObjectHandle object : mPreselectedObjects)
         {
-            for (const auto& objectPoint : object->getOutline())
+            for (const auto& objectPoint : (*object)->getOutline())
             {
                 // skip objects points outside of sensor cone
                 if (!bg::covered_by(objectPoint, detection.sensorCone)) {
@@ -104,16 +128,16 @@ SensorDetection FovSensor::detectObjects() const
                 lineOfSight[0] = detection.sensorOrigin;
                 lineOfSight[1] = objectPoint;
 
-                bool noVehicleOccultation = std::none_of(preselObjectsInSensorRange.begin(), preselObjectsInSensorRange.end(),
-                        [&](const std::shared_ptr<EnvironmentModelObject>& object) {
-                            return bg::crosses(lineOfSight, object->getOutline());
+                bool noVehicleOccultation = std::none_of(mPreselectedObjects.begin(), mPreselectedObjects.end(),
+                        [&](ObjectHandle other) {
+                            return bg::crosses(lineOfSight, (*other)->getOutline());
                         });
 
-                bool noObstacleOccultation = std::none_of(obstacleIntersections.begin(), obstacleIntersections.end(),
-                        [&](const std::shared_ptr<EnvironmentModelObstacle>& obstacle) {
-                            ASSERT(obstacle);
-                            if (bg::intersects(lineOfSight, obstacle->getOutline())) {
-                                blockingObstacles.insert(obstacle);
+                bool noObstacleOccultation = std::none_of(mPreselectedObstacles.begin(), mPreselectedObstacles.end(),
+                        [&](ObstacleHandle obstacle) {
+                            ASSERT(*obstacle);
+                            if (bg::intersects(lineOfSight, (*obstacle)->getOutline())) {
+                                mBlockingObstacles.push_back(obstacle);
                                 return true;
                             } else {
                                 return false;
@@ -121,8 +145,8 @@ SensorDetection FovSensor::detectObjects() const
                         });
 
                 if (noVehicleOccultation && noObstacleOccultation) {
-                    if (detection.objects.empty() || detection.objects.back() != object) {
-                        detection.objects.push_back(object);
+                    if (detection.objects.empty() || detection.objects.back() != *object) {
+                        detection.objects.push_back(*object);
                     }
 
                     if (mDrawLinesOfSight) {
@@ -135,36 +159,41 @@ SensorDetection FovSensor::detectObjects() const
             } // for each (corner) point of object polygon
         } // for each object
 
-        detection.obstacles.assign(blockingObstacles.begin(), blockingObstacles.end());
+        std::sort(mBlockingObstacles.begin(), mBlockingObstacles.end());
+        auto last = std::unique(mBlockingObstacles.begin(), mBlockingObstacles.end());
+        for (auto it = mBlockingObstacles.begin(); it != last; ++it) {
+            detection.obstacles.push_back(**it);
+        }
     } else {
-        for (const auto& object : preselObjectsInSensorRange) {
+        for (ObjectHandle object : mPreselectedObjects) {
             // preselection: object's bounding box and sensor cone's bounding box intersect
             // now: check if their actual geometries intersect somewhere
-            if (bg::intersects(object->getOutline(), detection.sensorCone)) {
-                detection.objects.push_back(object);
+            if (bg::intersects((*object)->getOutline(), detection.sensorCone)) {
+                detection.objects.push_back(*object);
             }
         }
     }
-
-    return detection;
 }
 
-SensorDetection FovSensor::createSensorCone() const
+void FovSensor::createSensorCone(SensorDetection& detection) const
 {
-    SensorDetection detection;
     const auto& egoObj = mGlobalEnvironmentModel->getObject(mFovConfig.egoID);
     if (egoObj) {
         detection.sensorOrigin = egoObj->getAttachmentPoint(mFovConfig.sensorPosition);
-        detection.sensorCone = createSensorArc(mFovConfig, *egoObj);
+        mSensorCone.place(*egoObj, detection.sensorCone, detection.sensorConeBounds);
     } else {
         throw std::runtime_error("no object found for ID " + mFovConfig.egoID);
     }
-    return detection;
 }
 
 void FovSensor::initializeVisualization()
 {
-    assert(mGroupFigure);
+    if (!mGroupFigure) {
+        // no visualization without GUI, skip also collection of visible points
+        mDrawLinesOfSight = false;
+        return;
+    }
+
     mDrawLinesOfSight = par("drawLinesOfSight");
     bool drawSensorCone = par("drawSensorCone");
     bool drawObjects = par("drawDetectedObjects");
@@ -243,64 +272,46 @@ void FovSensor::refreshDisplay() const
     }
 
     if (mSensorConeFigure) {
-        std::vector<cFigure::Point> points;
-        for (const auto& position : mLastDetection->sensorCone) {
-            points.push_back(cFigure::Point { position.x.value(), position.y.value() });
-        }
-        mSensorConeFigure->setPoints(points);
+        figures::assignPoints(mSensorConeFigure, mLastDetection->sensorCone);
     }
 
     if (mLinesOfSightFigure) {
-        // remove previous lines
-        while (mLinesOfSightFigure->getNumFigures() > 0) {
-            delete mLinesOfSightFigure->removeFigure(0);
-        }
-
         const Position& startPoint = mLastDetection->sensorOrigin;
+        int index = 0;
         for (const Position& endPoint : mLastDetection->visiblePoints) {
-            auto line = new cLineFigure();
+            auto line = figures::recycle<cLineFigure>(mLinesOfSightFigure, index++);
             line->setLineColor(mColor);
             line->setLineStyle(cFigure::LINE_DASHED);
             line->setStart(cFigure::Point { startPoint.x.value(), startPoint.y.value() });
             line->setEnd(cFigure::Point { endPoint.x.value(), endPoint.y.value() });
-            mLinesOfSightFigure->addFigure(line);
         }
+        figures::hideRemaining(mLinesOfSightFigure, index);
     }
 
     if (mObstaclesFigure) {
-        // remove previous obstacles
-        while (mObstaclesFigure->getNumFigures() > 0) {
-            delete mObstaclesFigure->removeFigure(0);
-        }
-
+        int index = 0;
         for (const auto& obstacle : mLastDetection->obstacles) {
-            auto polygon = new cPolygonFigure(obstacle->getObstacleId().c_str());
+            auto polygon = figures::recycle<cPolygonFigure>(mObstaclesFigure, index++);
+            polygon->setName(obstacle->getObstacleId().c_str());
             polygon->setFilled(true);
             polygon->setFillColor(mColor);
             polygon->setLineColor(cFigure::BLUE);
-            for (const auto& position : obstacle->getOutline()) {
-                polygon->addPoint(cFigure::Point { position.x.value(), position.y.value() });
-            }
-            mObstaclesFigure->addFigure(polygon);
+            figures::assignPoints(polygon, obstacle->getOutline());
         }
+        figures::hideRemaining(mObstaclesFigure, index);
     }
 
     if (mObjectsFigure) {
-        // remove previous objects
-        while (mObjectsFigure->getNumFigures() > 0) {
-            delete mObjectsFigure->removeFigure(0);
-        }
-
+        int index = 0;
         for (const auto& object : mLastDetection->objects) {
-            auto polygon = new cPolygonFigure(object->getExternalId().c_str());
+            auto polygon = figures::recycle<cPolygonFigure>(mObjectsFigure, index++);
+            polygon->setName(object->getExternalId().c_str());
             polygon->setFilled(true);
             polygon->setFillColor(mColor);
             polygon->setLineColor(cFigure::RED);
-            for (const auto& position : object->getOutline()) {
-                polygon->addPoint(cFigure::Point { position.x.value(), position.y.value() });
-            }
-            mObjectsFigure->addFigure(polygon);
+            figures::assignPoints(polygon, object->getOutline());
         }
+        figures::hideRemaining(mObjectsFigure, index);
     }
 }
 
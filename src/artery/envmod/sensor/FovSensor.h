@@ -7,12 +7,15 @@
 #ifndef ENVMOD_FOVRSENSOR_H_BCY7WDMB
 #define ENVMOD_FOVRSENSOR_H_BCY7WDMB
 
+#include "artery/envmod/GlobalEnvironmentModel.h"
 #include "artery/envmod/sensor/SensorConfiguration.h"
 #include "artery/envmod/sensor/SensorDetection.h"
 #include "artery/envmod/sensor/BaseSensor.h"
 #include <omnetpp/ccanvas.h>
 #include <memory>
 #include <functional>
+#include <utility>
+#include <vector>
 
 namespace artery
 {
@@ -31,12 +34,19 @@ public:
     void setSensorName(const std::string& name) override;
     SensorDetection detectObjects() const override;
 
+    /**
+     * Detect objects into a reusable detection buffer
+     * \param detection is overwritten, but its allocated capacity is reused
+     */
+    void detectObjects(SensorDetection& detection) const;
+
 protected:
     template<typename T>
     class Updatable
     {
     public:
         void operator=(T&& t) { mValue = std::move(t); mFlag = true; }
+        void swap(T& t) { std::swap(mValue, t); mFlag = true; }
         operator bool() const { bool tmp = mFlag; mFlag = false; return tmp; }
         const T* operator->() const { return &mValue; }
         const T& operator*() const { return mValue; }
@@ -50,13 +60,26 @@ protected:
     void finish() override;
     void initializeVisualization();
     void refreshDisplay() const override;
-    virtual SensorDetection createSensorCone() const;
+
+    /**
+     * Place sensor cone at current sensor pose
+     * \param detection sensorOrigin, sensorCone and sensorConeBounds are updated
+     */
+    virtual void createSensorCone(SensorDetection& detection) const;
 
     SensorConfigFov mFovConfig;
+    SensorCone mSensorCone;
     Updatable<SensorDetection> mLastDetection;
     bool mDrawLinesOfSight;
 
 private:
+    // scratch buffers reused by each measurement
+    SensorDetection mDetection;
+    mutable std::vector<GlobalEnvironmentModel::ObjectHandle> mPreselectedObjects;
+    mutable std::vector<GlobalEnvironmentModel::ObstacleHandle> mPreselectedObstacles;
+    mutable std::vector<GlobalEnvironmentModel::ObstacleHandle> mBlockingObstacles;
+    mutable bool mSensorConeValidated;
+
     omnetpp::cFigure::Color mColor;
     omnetpp::cGroupFigure* mGroupFigure;
     omnetpp::cPolygonFigure* mSensorConeFigure;
@@ -18,12 +18,10 @@ void RsuFovSensor::initialize()
     mFovHeading = Angle::from_degree(par("fovHeading"));
 }
 
-SensorDetection RsuFovSensor::createSensorCone() const
+void RsuFovSensor::createSensorCone(SensorDetection& detection) const
 {
-    SensorDetection detection;
     detection.sensorOrigin = getFacilities().get_const<PositionProvider>().getCartesianPosition();
-    detection.sensorCone = createSensorArc(mFovConfig, detection.sensorOrigin, mFovHeading);
-    return detection;
+    mSensorCone.place(detection.sensorOrigin, mFovHeading, detection.sensorCone, detection.sensorConeBounds);
 }
 
 } // namespace artery
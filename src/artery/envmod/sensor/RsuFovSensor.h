@@ -16,7 +16,7 @@ class RsuFovSensor : public FovSensor
 {
 protected:
     void initialize() override;
-    SensorDetection createSensorCone() const override;
+    void createSensorCone(SensorDetection&) const override;
 
     Angle mFovHeading;
 };
@@ -5,6 +5,8 @@
 #include <boost/math/constants/constants.hpp>
 #include <boost/units/cmath.hpp>
 #include <boost/units/systems/angle/degrees.hpp>
+#include <algorithm>
+#include <limits>
 
 namespace artery
 {
@@ -52,15 +54,74 @@ std::vector<Position> createSensorArc(const SensorConfigFov& config, const Posit
     return points;
 }
 
-std::vector<Position> createSensorArc(const SensorConfigFov& config, const EnvironmentModelObject& egoObj)
+namespace
+{
+
+Angle objectHeading(const EnvironmentModelObject& obj)
 {
     using boost::units::si::radians;
     static const auto pi = boost::math::constants::pi<double>();
     // heading from vehicle data is headed north (clockwise),
     // OMNeT++ angles are headed east (counter-clockwise)
-    const Angle heading = 0.5 * pi * radians - egoObj.getVehicleData().heading();
+    return 0.5 * pi * radians - obj.getVehicleData().heading();
+}
+
+} // namespace
+
+std::vector<Position> createSensorArc(const SensorConfigFov& config, const EnvironmentModelObject& egoObj)
+{
     Position sensorPos = egoObj.getAttachmentPoint(config.sensorPosition);
-    return createSensorArc(config, sensorPos, heading);
+    return createSensorArc(config, sensorPos, objectHeading(egoObj));
+}
+
+SensorCone::SensorCone(const SensorConfigFov& config) :
+    mSensorPosition(config.sensorPosition)
+{
+    const std::vector<Position> points = createSensorArc(config, Position { 0.0, 0.0 }, Angle { 0.0 });
+    mX.reserve(points.size());
+    mY.reserve(points.size());
+    for (const Position& point : points) {
+        mX.push_back(point.x.value());
+        mY.push_back(point.y.value());
+    }
+}
+
+void SensorCone::place(const Position& origin, const Angle& heading, std::vector<Position>& cone, geometry::Box& bounds) const
+{
+    namespace gm = boost::geometry;
+    using rotation = gm::strategy::transform::rotate_transformer<gm::degree, double, 2, 2>;
+
+    // derive matrix from unit vectors, i.e. follow Boost's rotation convention used by createSensorArc
+    const rotation rotate(heading.degree());
+    geometry::Point ex, ey;
+    gm::transform(geometry::Point { 1.0, 0.0 }, ex, rotate);
+    gm::transform(geometry::Point { 0.0, 1.0 }, ey, rotate);
+    const double m00 = gm::get<0>(ex), m10 = gm::get<1>(ex);
+    const double m01 = gm::get<0>(ey), m11 = gm::get<1>(ey);
+    const double tx = origin.x.value();
+    const double ty = origin.y.value();
+
+    const std::size_t size = mX.size();
+    cone.resize(size);
+    double minX = std::numeric_limits<double>::infinity();
+    double minY = minX;
+    double maxX = -minX;
+    double maxY = -minX;
+    for (std::size_t i = 0; i < size; ++i) {
+        const double x = m00 * mX[i] + m01 * mY[i] + tx;
+        const double y = m10 * mX[i] + m11 * mY[i] + ty;
+        cone[i] = Position { x, y };
+        minX = std::min(minX, x);
+        maxX = std::max(maxX, x);
+        minY = std::min(minY, y);
+        maxY = std::max(maxY, y);
+    }
+    bounds = geometry::Box { geometry::Point { minX, minY }, geometry::Point { maxX, maxY } };
+}
+
+void SensorCone::place(const EnvironmentModelObject& obj, std::vector<Position>& cone, geometry::Box& bounds) const
+{
+    place(obj.getAttachmentPoint(mSensorPosition), objectHeading(obj), cone, bounds);
 }
 
 } // namespace artery
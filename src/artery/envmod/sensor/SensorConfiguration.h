@@ -44,6 +44,41 @@ struct SensorConfigFov : public SensorConfig
 std::vector<Position> createSensorArc(const SensorConfigFov&, const Position&, const Angle&);
 std::vector<Position> createSensorArc(const SensorConfigFov&, const EnvironmentModelObject&);
 
+/**
+ * Sensor cone precomputed in the sensor's local frame
+ *
+ * The cone's shape depends only on the sensor configuration, thus its polygon is built
+ * once by createSensorArc. Placing the cone at a sensor's current pose is a single
+ * rotation and translation of all points, which is much cheaper than building the arc
+ * again by iterated segment rotations.
+ */
+class SensorCone
+{
+public:
+    SensorCone() = default;
+    explicit SensorCone(const SensorConfigFov&);
+
+    /**
+     * Place cone at sensor position
+     * \param origin sensor position
+     * \param heading sensor carrier's heading (OMNeT++ angle)
+     * \param cone receives polygon, previous content is replaced but capacity is reused
+     * \param bounds receives bounding box of polygon
+     */
+    void place(const Position& origin, const Angle& heading, std::vector<Position>& cone, geometry::Box& bounds) const;
+
+    /**
+     * Place cone at the configured attachment point of an object
+     */
+    void place(const EnvironmentModelObject&, std::vector<Position>& cone, geometry::Box& bounds) const;
+
+private:
+    SensorPosition mSensorPosition = SensorPosition::FRONT;
+    // local points stored column-wise for a tight transformation loop
+    std::vector<double> mX;
+    std::vector<double> mY;
+};
+
 } // namespace artery
 
 #endif /* SENSORCONFIGURATION_H_ */
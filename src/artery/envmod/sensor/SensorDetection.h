@@ -10,7 +10,6 @@
 #include "artery/envmod/EnvironmentModelObject.h"
 #include "artery/envmod/EnvironmentModelObstacle.h"
 #include "artery/utility/Geometry.h"
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -21,9 +20,21 @@ struct SensorDetection
 {
     Position sensorOrigin;
     std::vector<Position> sensorCone;
-    std::list<std::shared_ptr<EnvironmentModelObject>> objects;
-    std::list<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
-    std::list<Position> visiblePoints; // LOS = one of these points and first of sensorCone
+    geometry::Box sensorConeBounds; // bounding box of sensorCone
+    std::vector<std::shared_ptr<EnvironmentModelObject>> objects;
+    std::vector<std::shared_ptr<EnvironmentModelObstacle>> obstacles;
+    std::vector<Position> visiblePoints; // LOS = one of these points and first of sensorCone
+
+    /**
+     * Reset detection but keep allocated capacity for reuse by the next measurement
+     */
+    void clear()
+    {
+        sensorCone.clear();
+        objects.clear();
+        obstacles.clear();
+        visiblePoints.clear();
+    }
 };
 
 } // namespace artery
@@ -0,0 +1,78 @@
+/*
+ * Placing a precomputed SensorCone has to yield the same polygon as createSensorArc
+ */
+
+#include "artery/envmod/sensor/SensorConfiguration.h"
+#include <boost/units/systems/si/length.hpp>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <limits>
+
+namespace
+{
+
+const double tolerance = 1e-9; /*< metres */
+
+} // namespace
+
+int main()
+{
+    using namespace artery;
+    using boost::units::si::meters;
+    using boost::units::degree::degrees;
+
+    unsigned checks = 0;
+    unsigned failures = 0;
+    std::vector<Position> cone;
+    geometry::Box bounds;
+
+    for (SensorPosition position : { SensorPosition::FRONT, SensorPosition::BACK, SensorPosition::LEFT, SensorPosition::RIGHT }) {
+        for (double fov : { 1.0, 30.0, 90.0, 179.0, 270.0, 359.0, 360.0 }) {
+            for (unsigned segments : { 0u, 1u, 4u, 17u, 64u }) {
+                SensorConfigFov config;
+                config.sensorPosition = position;
+                config.fieldOfView.range = 80.0 * meters;
+                config.fieldOfView.angle = fov * degrees;
+                config.numSegments = segments;
+                const SensorCone sensorCone(config);
+
+                for (double heading = -360.0; heading <= 720.0; heading += 7.5) {
+                    const Position origin { 4321.5 + heading, -1234.25 - 0.5 * heading };
+                    const Angle angle = Angle::from_degree(heading);
+                    const std::vector<Position> arc = createSensorArc(config, origin, angle);
+                    sensorCone.place(origin, angle, cone, bounds);
+                    ++checks;
+
+                    double deviation = cone.size() == arc.size() ? 0.0 : std::numeric_limits<double>::infinity();
+                    double minX = std::numeric_limits<double>::infinity();
+                    double minY = minX;
+                    double maxX = -minX;
+                    double maxY = -minX;
+                    for (std::size_t i = 0; i < std::min(cone.size(), arc.size()); ++i) {
+                        deviation = std::max(deviation, distance(cone[i], arc[i]).value());
+                        minX = std::min(minX, arc[i].x.value());
+                        minY = std::min(minY, arc[i].y.value());
+                        maxX = std::max(maxX, arc[i].x.value());
+                        maxY = std::max(maxY, arc[i].y.value());
+                    }
+                    deviation = std::max({ deviation,
+                        std::abs(bounds.min_corner().get<0>() - minX), std::abs(bounds.min_corner().get<1>() - minY),
+                        std::abs(bounds.max_corner().get<0>() - maxX), std::abs(bounds.max_corner().get<1>() - maxY) });
+
+                    if (!(deviation <= tolerance)) {
+                        std::cerr << "sensor cone at " << static_cast<int>(position) << " with " << fov << " degree FoV, "
+                            << segments << " segments and heading " << heading << " deviates by " << deviation << " m\n";
+                        ++failures;
+                    }
+                }
+            }
+        }
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " of " << checks << " placements deviate from createSensorArc" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -44,6 +44,8 @@ void CollectivePerceptionMockService::initialize(int stage)
         ItsG5Service::initialize();
         mPositionProvider = &getFacilities().get_const<PositionProvider>();
         mEnvironmentModel = &getFacilities().get_const<LocalEnvironmentModel>();
+        mMultiChannelPolicy = &getFacilities().get_const<MultiChannelPolicy>();
+        mNetworkInterfaceTable = &getFacilities().get_const<NetworkInterfaceTable>();
 
         mDccProfile = par("dccProfile");
         mLengthHeader = par("lengthHeader");
@@ -94,8 +96,8 @@ void CollectivePerceptionMockService::receiveSignal(omnetpp::cComponent*, omnetp
 void CollectivePerceptionMockService::trigger()
 {
     if (!mGenerateAfterCam && !mTrigger->isScheduled()) {
-        auto channel = getFacilities().get_const<MultiChannelPolicy>().primaryChannel(vanetza::aid::CP);
-        auto netifc = notNullPtr(getFacilities().get_const<NetworkInterfaceTable>().select(channel));
+        auto channel = mMultiChannelPolicy->primaryChannel(vanetza::aid::CP);
+        auto netifc = notNullPtr(mNetworkInterfaceTable->select(channel));
         vanetza::dcc::TransmitRateThrottle* trc = notNullPtr(netifc->getDccEntity().getTransmitRateThrottle());
         vanetza::dcc::TransmissionLite tx { static_cast<vanetza::dcc::Profile>(mDccProfile), 0 };
         const omnetpp::SimTime interval = std::chrono::duration<double>(trc->interval(tx)).count();
@@ -34,6 +34,8 @@ class CollectivePerceptionMockService : public ItsG5Service
         int mHostId = 0;
         const PositionProvider* mPositionProvider = nullptr;
         const LocalEnvironmentModel* mEnvironmentModel = nullptr;
+        const MultiChannelPolicy* mMultiChannelPolicy = nullptr;
+        const NetworkInterfaceTable* mNetworkInterfaceTable = nullptr;
         omnetpp::cMessage* mTrigger = nullptr;
         bool mGenerateAfterCam;
         omnetpp::SimTime mCpmOffset;
@@ -8,6 +8,8 @@
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/VehicleIndex.h"
 #include <inet/common/ModuleAccess.h>
+#include <chrono>
+#include <string>
 
 namespace artery
 {
@@ -16,11 +18,27 @@ namespace gemv2
 
 Define_Module(LinkClassifier)
 
+namespace
+{
+
+// weight of latest observation in clearance rate
+const double clearanceRateWeight = 1.0 / 64.0;
+
+const char* linkClassNames[] = { "LOS", "NLOSb", "NLOSf", "NLOSv" };
+
+} // namespace
+
 void LinkClassifier::initialize()
 {
-    mObstacleIndex = inet::findModuleFromPar<ObstacleIndex>(par("obstacleIndexModule"), this);
-    mFoliageIndex = inet::findModuleFromPar<ObstacleIndex>(par("foliageIndexModule"), this);
+    mBuildings = ObstacleCheck();
+    mBuildings.index = inet::findModuleFromPar<ObstacleIndex>(par("obstacleIndexModule"), this);
+    mFoliage = ObstacleCheck();
+    mFoliage.index = inet::findModuleFromPar<ObstacleIndex>(par("foliageIndexModule"), this);
     mVehicleIndex = inet::findModuleFromPar<VehicleIndex>(par("vehicleIndexModule"), this);
+    mMinClearanceRate = par("minClearanceRate");
+    mProbeInterval = par("probeInterval");
+    mMeasureTime = par("measureTime");
+    mClassCosts.fill(ClassCost());
 
     WATCH(mCountLOS);
     WATCH(mCountNLOSb);
@@ -34,25 +52,84 @@ void LinkClassifier::finish()
     recordScalar("countNLOSb", mCountNLOSb);
     recordScalar("countNLOSf", mCountNLOSf);
     recordScalar("countNLOSv", mCountNLOSv);
+
+    for (std::size_t i = 0; i < mClassCosts.size(); ++i) {
+        const std::string name = linkClassNames[i];
+        const ClassCost& cost = mClassCosts[i];
+        recordScalar(("gridChecks" + name).c_str(), cost.gridChecks);
+        recordScalar(("queries" + name).c_str(), cost.queries);
+        if (mMeasureTime) {
+            recordScalar(("time" + name).c_str(), cost.time, "s");
+        }
+    }
+
+    recordScalar("gridClearancesBuildings", mBuildings.gridClearances);
+    recordScalar("gridClearancesFoliage", mFoliage.gridClearances);
 }
 
 LinkClass LinkClassifier::classifyLink(const Position& tx, const Position& rx) const
 {
+    using clock = std::chrono::steady_clock;
+    const clock::time_point start = mMeasureTime ? clock::now() : clock::time_point();
+
+    ClassCost cost;
     LinkClass link = LinkClass::LOS;
-    if (mObstacleIndex->anyBlockage(tx, rx)) {
+    if (isBlocked(mBuildings, tx, rx, cost)) {
         link = LinkClass::NLOSb;
         ++mCountNLOSb;
-    } else if (mFoliageIndex->anyBlockage(tx, rx)) {
+    } else if (isBlocked(mFoliage, tx, rx, cost)) {
         link = LinkClass::NLOSf;
         ++mCountNLOSf;
-    } else if (mVehicleIndex->anyBlockage(tx, rx)) {
-        link = LinkClass::NLOSv;
-        ++mCountNLOSv;
     } else {
-        ++mCountLOS;
+        ++cost.queries;
+        if (mVehicleIndex->anyBlockage(tx, rx)) {
+            link = LinkClass::NLOSv;
+            ++mCountNLOSv;
+        } else {
+            ++mCountLOS;
+        }
+    }
+
+    ClassCost& total = mClassCosts[static_cast<std::size_t>(link)];
+    total.gridChecks += cost.gridChecks;
+    total.queries += cost.queries;
+    if (mMeasureTime) {
+        total.time += std::chrono::duration<double>(clock::now() - start).count();
     }
     return link;
 }
 
+bool LinkClassifier::isBlocked(ObstacleCheck& check, const Position& tx, const Position& rx, ClassCost& cost) const
+{
+    if (useOccupancyGrid(check)) {
+        ++cost.gridChecks;
+        const bool cleared = !check.index->mayBlock(tx, rx);
+        check.clearanceRate += clearanceRateWeight * ((cleared ? 1.0 : 0.0) - check.clearanceRate);
+        if (cleared) {
+            ++check.gridClearances;
+            return false;
+        }
+    }
+
+    ++cost.queries;
+    return check.index->anyBlockage(tx, rx);
+}
+
+bool LinkClassifier::useOccupancyGrid(ObstacleCheck& check) const
+{
+    if (!check.index->hasOccupancyGrid()) {
+        return false;
+    } else if (check.clearanceRate >= mMinClearanceRate) {
+        check.linksSinceProbe = 0;
+        return true;
+    } else if (++check.linksSinceProbe >= mProbeInterval) {
+        // probe grid occasionally, the environment along links may have changed
+        check.linksSinceProbe = 0;
+        return true;
+    } else {
+        return false;
+    }
+}
+
 } // namespace gemv2
 } // namespace artery
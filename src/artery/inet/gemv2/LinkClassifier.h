@@ -9,6 +9,7 @@
 
 #include "LinkClass.h"
 #include <omnetpp/csimplemodule.h>
+#include <array>
 
 namespace artery
 {
@@ -23,6 +24,14 @@ namespace gemv2
 class ObstacleIndex;
 class VehicleIndex;
 
+/**
+ * LinkClassifier determines the class of a link by checking buildings, foliage and vehicles
+ *
+ * Classes are prioritized in this order, i.e. foliage is only checked if no building blocks the link.
+ * Before querying an obstacle index, its occupancy grid may rule out any blockage cheaply.
+ * Grid checks are skipped (apart from occasional probes) while they rarely rule out blockages,
+ * e.g. in dense urban areas, so the classification cost follows the observed link classes.
+ */
 class LinkClassifier : public omnetpp::cSimpleModule
 {
 public:
@@ -31,18 +40,45 @@ public:
     LinkClass classifyLink(const Position& tx, const Position& rx) const;
 
 private:
-    const ObstacleIndex* mObstacleIndex;
-    const ObstacleIndex* mFoliageIndex;
+    /**
+     * Adaptive usage of an obstacle index's occupancy grid
+     */
+    struct ObstacleCheck
+    {
+        const ObstacleIndex* index = nullptr;
+        double clearanceRate = 1.0; /*< moving average of links cleared by occupancy grid */
+        unsigned linksSinceProbe = 0;
+        unsigned long gridClearances = 0;
+    };
+
+    /**
+     * Cost of classifying links of one class
+     */
+    struct ClassCost
+    {
+        unsigned long gridChecks = 0;
+        unsigned long queries = 0; /*< exact queries of obstacle and vehicle indices */
+        double time = 0.0; /*< wall-clock time in seconds if measured */
+    };
+
+    bool isBlocked(ObstacleCheck&, const Position& tx, const Position& rx, ClassCost&) const;
+    bool useOccupancyGrid(ObstacleCheck&) const;
+
+    mutable ObstacleCheck mBuildings;
+    mutable ObstacleCheck mFoliage;
     const VehicleIndex* mVehicleIndex;
+    double mMinClearanceRate;
+    unsigned mProbeInterval;
+    bool mMeasureTime;
 
     mutable unsigned mCountLOS = 0;
     mutable unsigned mCountNLOSb = 0;
     mutable unsigned mCountNLOSf = 0;
     mutable unsigned mCountNLOSv = 0;
+    mutable std::array<ClassCost, 4> mClassCosts;
 };
 
 } // namespace gemv2
 } // namespace artery
 
 #endif /* LINKCLASSIFIER_H_OAXCBN1T */
-
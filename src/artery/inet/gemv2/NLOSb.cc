@@ -87,7 +87,7 @@ void NLOSb::initialize()
         error("Invalid antenna polarization %s", polarization_str.c_str());
     }
 
-    mVisualizer = inet::findModuleFromPar<Visualizer>(par("visualizerModule"), this, false);
+    mVisualizer = findVisualizer(this);
 }
 
 NLOSb::NLOSb() :
@@ -35,7 +35,7 @@ void NLOSf::initialize(int stage)
     FreeSpacePathLoss::initialize(stage);
     if (stage == INITSTAGE_LOCAL) {
         mFoliageIndex = inet::findModuleFromPar<ObstacleIndex>(par("foliageIndexModule"), this);
-        mVisualizer = inet::findModuleFromPar<Visualizer>(par("visualizerModule"), this, false);
+        mVisualizer = findVisualizer(this);
     }
 }
 
@@ -6,19 +6,18 @@
 
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/Visualizer.h"
-#include "artery/traci/Cast.h"
 #include "traci/API.h"
 #include "traci/Core.h"
 #include <boost/algorithm/string.hpp>
 #include <boost/geometry.hpp>
 #include <boost/geometry/geometries/register/linestring.hpp>
-#include <boost/range/adaptor/indexed.hpp>
-#include <boost/range/adaptor/transformed.hpp>
 #include <boost/units/cmath.hpp>
 #include <inet/common/ModuleAccess.h>
 #include <omnetpp/checkandcast.h>
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <limits>
 
 namespace bg = boost::geometry;
 
@@ -37,6 +36,11 @@ namespace bg = boost::geometry;
 
 namespace {
     const simsignal_t traciInitSignal = cComponent::registerSignal("traci.init");
+
+    // upper bound of occupancy grid cells, coarser cells are used for huge scenarios
+    const std::size_t maxOccupancyCells = 1 << 24;
+    // margin around obstacles compensating rounding in grid traversal
+    const double occupancyMargin = 0.01;
 }
 
 
@@ -49,11 +53,14 @@ void ObstacleIndex::initialize()
         throw cRuntimeError("No TraCI module found for signal subscription");
     }
 
-    mFilterTypes.clear();
+    mFilter.types.clear();
     const std::string filterTypes = par("filterTypes");
-    boost::split(mFilterTypes, filterTypes, boost::is_any_of(" "));
+    boost::split(mFilter.types, filterTypes, boost::is_any_of(" "));
+    mFilter.requireFilled = par("requireFilled");
+    StaticObstacles::instance().announce(mFilter, ObstacleSnapshotFile::fromParameters(*this));
+    mOccupancyGridEnabled = par("occupancyCellSize").doubleValue() > 0.0;
 
-    mVisualizer = inet::findModuleFromPar<Visualizer>(par("visualizerModule"), this, false);
+    mVisualizer = findVisualizer(this);
     mColor = cFigure::Color(par("obstacleColor"));
 }
 
@@ -71,71 +78,30 @@ void ObstacleIndex::receiveSignal(cComponent* source, simsignal_t signal, const
 
 void ObstacleIndex::fetchObstacles(const traci::API& traci)
 {
-    const auto& polygons = traci.polygon;
-    const traci::Boundary boundary { traci.simulation.getNetBoundary() };
-    const bool require_filled = par("requireFilled");
-    unsigned ignored = 0;
-    std::string shape_msg;
-    for (const std::string& id : polygons.getIDList()) {
-        if (!mFilterTypes.empty()) {
-            std::string type = polygons.getType(id);
-            auto found = mFilterTypes.find(type);
-            if (found == mFilterTypes.end()) {
-                EV_DEBUG << "ignore polygon " << id << " of type " << type << "\n";
-                // skip polygon because its type is not in our filter set
-                ++ignored;
-                continue;
-            }
-        }
-
-        if (require_filled) {
-            if (!polygons.getFilled(id)) {
-                EV_DEBUG << "ignore unfilled polygon " << id << "\n";
-                ++ignored;
-                continue;
-            }
-        }
-
-        std::vector<Position> shape;
-        for (const traci::TraCIPosition& point : polygons.getShape(id).value) {
-            bg::append(shape, traci::position_cast(boundary, point));
-        }
-
-        bg::correct(shape); // fixes issues such as reversed point order
-        if (!bg::is_valid(shape, shape_msg)) {
-            EV_DEBUG << "ignore invalid polygon " << id << " (" << shape_msg << ")\n";
-            ++ignored;
-            continue;
-        }
+    mObstacles = StaticObstacles::instance().getView(traci, mFilter);
+    EV_INFO << mObstacles.size() << " obstacles stored\n";
 
-        mObstacles.emplace_back(std::move(shape));
+    if (mOccupancyGridEnabled) {
+        mOccupancyGrid = OccupancyGrid { mObstacles, par("occupancyCellSize").doubleValue() };
+        EV_INFO << mOccupancyGrid.getOccupiedCells() << " of " << mOccupancyGrid.getCells()
+            << " occupancy grid cells (" << mOccupancyGrid.getCellSize() << " m) are occupied\n";
     }
-
-    struct rtree_value_maker
-    {
-        RtreeValue operator()(const boost::range::index_value<Obstacle&>& v) const
-        {
-            using Indexable = typename RtreeValue::first_type;
-            return RtreeValue { bg::return_envelope<Indexable>(v.value().getOutline()), v.index() };
-        }
-    };
-
-    using namespace boost::adaptors;
-    Rtree tree { mObstacles | indexed() | transformed(rtree_value_maker()) };
-    mObstacleRtree = std::move(tree);
-    EV_INFO << mObstacles.size() << " obstacles stored (" << ignored << " ignored)\n";
 }
 
 bool ObstacleIndex::anyBlockage(const Position& a, const Position& b) const
 {
     const LineOfSight los { a, b };
-    auto rtree_intersect = bg::index::intersects(los);
-    return std::any_of(mObstacleRtree.qbegin(rtree_intersect), mObstacleRtree.qend(),
-            [&](const RtreeValue& candidate) {
-                return bg::crosses(los, mObstacles[candidate.second].getOutline());
+    return !mObstacles.query(bg::index::intersects(los),
+            [&los](const std::shared_ptr<Obstacle>& obstacle) {
+                return !bg::crosses(los, obstacle->getOutline());
             });
 }
 
+bool ObstacleIndex::mayBlock(const Position& a, const Position& b) const
+{
+    return !mOccupancyGridEnabled || mOccupancyGrid.mayIntersect(a, b);
+}
+
 std::vector<const ObstacleIndex::Obstacle*>
 ObstacleIndex::obstaclesEllipse(const Position& a, const Position& b, double r) const
 {
@@ -155,15 +121,14 @@ ObstacleIndex::obstaclesEllipse(const Position& a, const Position& b, double r)
         bg::set<bg::max_corner, 0>(ebb, fmax(a.x, b.x).value() + k); // right
         bg::set<bg::max_corner, 1>(ebb, fmax(a.y, b.y).value() + k); // bottom
 
-        auto rtree_intersect = bg::index::intersects(ebb);
-        for (auto it = mObstacleRtree.qbegin(rtree_intersect); it != mObstacleRtree.qend(); ++it) {
-            const Obstacle& obstacle = mObstacles[it->second];
-            const Position& c = obstacle.getCentroid();
+        mObstacles.query(bg::index::intersects(ebb), [&](const std::shared_ptr<Obstacle>& obstacle) {
+            const Position& c = obstacle->getCentroid();
             if (bg::distance(a, c) + bg::distance(b, c) <= r) {
                 // obstacle's center is within ellipse
-                obstacles.push_back(&obstacle);
+                obstacles.push_back(obstacle.get());
             }
-        }
+            return true;
+        });
     }
 
     return obstacles;
@@ -174,21 +139,135 @@ ObstacleIndex::getObstructingObstacles(const Position& a, const Position& b) con
 {
     std::vector<const Obstacle*> result;
     const LineOfSight los { a, b };
-    auto rtree_intersect = bg::index::intersects(los);
-    for (auto it = mObstacleRtree.qbegin(rtree_intersect); it != mObstacleRtree.qend(); ++it) {
-        const Obstacle& obstacle = mObstacles[it->second];
-        if (bg::crosses(los, obstacle.getOutline())) {
-            result.push_back(&obstacle);
+    mObstacles.query(bg::index::intersects(los), [&](const std::shared_ptr<Obstacle>& obstacle) {
+        if (bg::crosses(los, obstacle->getOutline())) {
+            result.push_back(obstacle.get());
         }
-    }
+        return true;
+    });
     return result;
 }
 
-ObstacleIndex::Obstacle::Obstacle(std::vector<Position>&& shape) :
-    mOutline(shape),
-    mCentroid(bg::return_centroid<Position>(mOutline)),
-    mArea(bg::area(mOutline))
+OccupancyGrid::OccupancyGrid(const StaticObstacleView& obstacles, double cellSize) :
+    mCellSize(cellSize)
+{
+    if (obstacles.empty()) {
+        return;
+    }
+
+    geometry::Box bounds;
+    bg::assign_inverse(bounds);
+    obstacles.forEach([&bounds](const std::shared_ptr<StaticObstacle>& obstacle) {
+        bg::expand(bounds, obstacle->getBoundingBox());
+    });
+
+    mOriginX = bounds.min_corner().get<0>() - occupancyMargin;
+    mOriginY = bounds.min_corner().get<1>() - occupancyMargin;
+    const double width = bounds.max_corner().get<0>() + occupancyMargin - mOriginX;
+    const double height = bounds.max_corner().get<1>() + occupancyMargin - mOriginY;
+    const double cells = std::ceil(width / mCellSize) * std::ceil(height / mCellSize);
+    if (cells > maxOccupancyCells) {
+        mCellSize *= std::sqrt(cells / maxOccupancyCells);
+    }
+    mColumns = static_cast<std::size_t>(std::ceil(width / mCellSize));
+    mRows = static_cast<std::size_t>(std::ceil(height / mCellSize));
+    mCells.assign(mColumns * mRows, false);
+
+    auto column = [this](double x) {
+        return std::min(static_cast<std::size_t>(std::max(0.0, (x - mOriginX) / mCellSize)), mColumns - 1);
+    };
+    auto row = [this](double y) {
+        return std::min(static_cast<std::size_t>(std::max(0.0, (y - mOriginY) / mCellSize)), mRows - 1);
+    };
+
+    obstacles.forEach([&](const std::shared_ptr<StaticObstacle>& obstacle) {
+        const geometry::Box& box = obstacle->getBoundingBox();
+        const std::size_t lastColumn = column(box.max_corner().get<0>() + occupancyMargin);
+        const std::size_t lastRow = row(box.max_corner().get<1>() + occupancyMargin);
+        for (std::size_t r = row(box.min_corner().get<1>() - occupancyMargin); r <= lastRow; ++r) {
+            for (std::size_t c = column(box.min_corner().get<0>() - occupancyMargin); c <= lastColumn; ++c) {
+                mCells[r * mColumns + c] = true;
+            }
+        }
+    });
+}
+
+bool OccupancyGrid::mayIntersect(const Position& a, const Position& b) const
+{
+    if (mCells.empty()) {
+        return false;
+    }
+
+    // segment in grid coordinates, i.e. cell (c, r) spans [c, c+1) x [r, r+1)
+    const double x0 = (a.x.value() - mOriginX) / mCellSize;
+    const double y0 = (a.y.value() - mOriginY) / mCellSize;
+    const double dx = (b.x.value() - mOriginX) / mCellSize - x0;
+    const double dy = (b.y.value() - mOriginY) / mCellSize - y0;
+
+    // clip segment to grid (Liang-Barsky)
+    double t0 = 0.0;
+    double t1 = 1.0;
+    auto clip = [&t0, &t1](double p, double q) {
+        if (p == 0.0) {
+            return q >= 0.0;
+        }
+        const double t = q / p;
+        if (p < 0.0) {
+            t0 = std::max(t0, t);
+        } else {
+            t1 = std::min(t1, t);
+        }
+        return t0 <= t1;
+    };
+    if (!clip(-dx, x0) || !clip(dx, mColumns - x0) || !clip(-dy, y0) || !clip(dy, mRows - y0)) {
+        return false;
+    }
+
+    // traverse cells along clipped segment (Amanatides-Woo)
+    const double sx = x0 + t0 * dx;
+    const double sy = y0 + t0 * dy;
+    auto cell = [](double v, std::size_t n) {
+        return std::min(static_cast<std::size_t>(std::max(0.0, v)), n - 1);
+    };
+    std::size_t column = cell(sx, mColumns);
+    std::size_t row = cell(sy, mRows);
+    const std::size_t lastColumn = cell(x0 + t1 * dx, mColumns);
+    const std::size_t lastRow = cell(y0 + t1 * dy, mRows);
+
+    const double inf = std::numeric_limits<double>::infinity();
+    const double deltaX = dx != 0.0 ? std::abs(1.0 / dx) : inf;
+    const double deltaY = dy != 0.0 ? std::abs(1.0 / dy) : inf;
+    double nextX = dx > 0.0 ? t0 + (column + 1 - sx) * deltaX : dx < 0.0 ? t0 + (sx - column) * deltaX : inf;
+    double nextY = dy > 0.0 ? t0 + (row + 1 - sy) * deltaY : dy < 0.0 ? t0 + (sy - row) * deltaY : inf;
+
+    for (std::size_t steps = mColumns + mRows; steps > 0; --steps) {
+        if (isOccupied(column, row)) {
+            return true;
+        } else if (column == lastColumn && row == lastRow) {
+            break;
+        }
+
+        if (nextX < nextY) {
+            if (dx > 0.0 ? column + 1 >= mColumns : column == 0) {
+                break;
+            }
+            column = dx > 0.0 ? column + 1 : column - 1;
+            nextX += deltaX;
+        } else {
+            if (dy > 0.0 ? row + 1 >= mRows : row == 0) {
+                break;
+            }
+            row = dy > 0.0 ? row + 1 : row - 1;
+            nextY += deltaY;
+        }
+    }
+
+    return false;
+}
+
+std::size_t OccupancyGrid::getOccupiedCells() const
 {
+    return std::count(mCells.begin(), mCells.end(), true);
 }
 
 } // namespace gemv2
@@ -7,13 +7,11 @@
 #ifndef OBSTACLEINDEX_H_WKZBN6QH
 #define OBSTACLEINDEX_H_WKZBN6QH
 
+#include "artery/traci/StaticObstacles.h"
 #include "artery/utility/Geometry.h"
-#include <boost/geometry/index/rtree.hpp>
 #include <omnetpp/ccanvas.h>
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
-#include <set>
-#include <string>
 #include <vector>
 
 // forward declaration
@@ -26,22 +24,48 @@ namespace gemv2
 
 class Visualizer;
 
+/**
+ * OccupancyGrid marks all cells covered by bounding boxes of obstacles
+ *
+ * A line segment traversing only free cells cannot cross any obstacle,
+ * i.e. the grid is a cheap but conservative bound for line of sight checks.
+ */
+class OccupancyGrid
+{
+public:
+    OccupancyGrid() = default;
+    OccupancyGrid(const StaticObstacleView&, double cellSize);
+
+    /**
+     * Check if segment between a and b traverses any occupied cell
+     * \return false if no obstacle can intersect this segment
+     */
+    bool mayIntersect(const Position& a, const Position& b) const;
+
+    double getCellSize() const { return mCellSize; }
+    std::size_t getCells() const { return mCells.size(); }
+    std::size_t getOccupiedCells() const;
+
+private:
+    bool isOccupied(std::size_t column, std::size_t row) const { return mCells[row * mColumns + column]; }
+
+    double mOriginX = 0.0;
+    double mOriginY = 0.0;
+    double mCellSize = 0.0;
+    std::size_t mColumns = 0;
+    std::size_t mRows = 0;
+    std::vector<bool> mCells;
+};
+
+/**
+ * ObstacleIndex is a view on static obstacles of selected types
+ *
+ * Obstacles and their R-trees are shared with other indices and the environment model.
+ */
 class ObstacleIndex : public omnetpp::cSimpleModule, public omnetpp::cListener
 {
 public:
-    class Obstacle
-    {
-    public:
-        Obstacle(std::vector<Position>&& shape);
-        const std::vector<Position>& getOutline() const { return mOutline; }
-        double getArea() const { return mArea; }
-        const Position& getCentroid() const { return mCentroid; }
-
-    private:
-        std::vector<Position> mOutline;
-        Position mCentroid;
-        double mArea;
-    };
+    using Obstacle = StaticObstacle;
 
     // cSimpleModule
     void initialize() override;
@@ -51,6 +75,17 @@ public:
 
     bool anyBlockage(const Position& a, const Position& b) const;
 
+    /**
+     * Cheap conservative check by occupancy grid
+     * \return false if no obstacle can block line of sight between a and b
+     */
+    bool mayBlock(const Position& a, const Position& b) const;
+
+    /**
+     * Check if mayBlock is backed by an occupancy grid, i.e. it is worth calling
+     */
+    bool hasOccupancyGrid() const { return mOccupancyGridEnabled; }
+
     /**
      * Get obstacles with their center point being within the defined ellipse.
      *
@@ -71,9 +106,9 @@ public:
 
     /**
      * Get all currently indexed obstacles
-     * \return obstacles
+     * \return view on obstacles
      */
-    const std::vector<Obstacle>& getObstacles() const { return mObstacles; }
+    const StaticObstacleView& getObstacles() const { return mObstacles; }
 
     /**
      * Get default color for drawing obstacles
@@ -84,12 +119,10 @@ public:
 private:
     void fetchObstacles(const traci::API&);
 
-    using RtreeValue = std::pair<geometry::Box, std::size_t>;
-    using Rtree = boost::geometry::index::rtree<RtreeValue, boost::geometry::index::rstar<16>>;
-
-    std::set<std::string> mFilterTypes;
-    std::vector<Obstacle> mObstacles;
-    Rtree mObstacleRtree;
+    ObstacleFilter mFilter;
+    StaticObstacleView mObstacles;
+    OccupancyGrid mOccupancyGrid;
+    bool mOccupancyGridEnabled = false;
     Visualizer* mVisualizer = nullptr;
     omnetpp::cFigure::Color mColor;
 };
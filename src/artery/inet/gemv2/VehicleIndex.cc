@@ -52,7 +52,7 @@ void VehicleIndex::initialize()
         throw cRuntimeError("No TraCI module found for signal subscription");
     }
 
-    mVisualizer = inet::findModuleFromPar<Visualizer>(par("visualizerModule"), this, false);
+    mVisualizer = findVisualizer(this);
     mVehicleMargin = std::abs(par("vehicleMargin").doubleValue());
 }
 
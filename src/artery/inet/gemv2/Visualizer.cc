@@ -1,6 +1,9 @@
 #include "artery/inet/gemv2/Visualizer.h"
 #include "artery/inet/gemv2/ObstacleIndex.h"
 #include "artery/inet/gemv2/VehicleIndex.h"
+#include "artery/utility/FigureRecycling.h"
+#include <inet/common/ModuleAccess.h>
+#include <array>
 
 namespace artery
 {
@@ -11,7 +14,7 @@ Define_Module(Visualizer)
 
 void Visualizer::initialize(int stage)
 {
-    if (stage == 0) {
+    if (stage == 0 && hasGUI()) {
         mVehicleGroup = new omnetpp::cGroupFigure("vehicles");
         mRaysGroup = new omnetpp::cGroupFigure("rays");
 
@@ -46,70 +49,50 @@ omnetpp::cGroupFigure* Visualizer::getObstacleGroup(const omnetpp::cModule* modu
 
 void Visualizer::drawObstacles(const ObstacleIndex* index)
 {
-    omnetpp::cGroupFigure* group = getObstacleGroup(index);
-    for (int i = group->getNumFigures() - 1; i >= 0; --i)
-    {
-        delete group->removeFigure(i);
+    if (!hasGUI()) {
+        return;
     }
 
-    auto obstacles = index->getObstacles();
-    for (auto& obstacle : obstacles)
-    {
-        auto polygon = new omnetpp::cPolygonFigure();
+    omnetpp::cGroupFigure* group = getObstacleGroup(index);
+    int figureIndex = 0;
+    index->getObstacles().forEach([&](const std::shared_ptr<ObstacleIndex::Obstacle>& obstacle) {
+        auto polygon = figures::recycle<omnetpp::cPolygonFigure>(group, figureIndex++);
         polygon->setLineColor(index->getColor());
-        for (const Position& pos : obstacle.getOutline())
-        {
-            polygon->addPoint(omnetpp::cFigure::Point { pos.x.value(), pos.y.value() });
-        }
-        group->addFigure(polygon);
-    }
+        figures::assignPoints(polygon, obstacle->getOutline());
+    });
+    figures::hideRemaining(group, figureIndex);
 }
 
 void Visualizer::drawVehicles(const VehicleIndex* index)
 {
-    auto vehicles = index->getVehicles();
+    // vehicle figures are updated lazily by refreshDisplay
+    mVehicleIndex = index;
+    mVehiclesDirty = true;
 
-    // remove vehicles that do not exist longer
-    for (auto it = mVehiclePolygons.begin(); it != mVehiclePolygons.end();)
-    {
-        auto found = vehicles.find(it->first);
-        if (found != vehicles.end()) {
-            ++it;
-        } else {
-            delete it->second->removeFromParent();
-            it = mVehiclePolygons.erase(it);
-        }
+    // rays drawn since previous vehicle update are outdated now
+    mNumRays = 0;
+}
+
+void Visualizer::refreshDisplay() const
+{
+    if (mRaysGroup) {
+        figures::hideRemaining(mRaysGroup, mNumRays);
     }
 
-    for (auto& name_vehicle : vehicles)
-    {
-        auto found = mVehiclePolygons.find(name_vehicle.first);
-        if (found == mVehiclePolygons.end()) {
-            // insert new vehicle polygon
-            omnetpp::cPolygonFigure* polygon = new omnetpp::cPolygonFigure(name_vehicle.first.c_str());
-            mVehicleGroup->addFigure(polygon);
-            mVehiclePolygons[name_vehicle.first] = polygon;
-            for (const Position& pos : name_vehicle.second.getOutline())
-            {
-                polygon->addPoint(omnetpp::cFigure::Point { pos.x.value(), pos.y.value() });
-            }
-            polygon->setLineColor(omnetpp::cFigure::BLUE);
-        } else {
-            // update existing polygon
-            omnetpp::cPolygonFigure* polygon = found->second;
-            auto& outline = name_vehicle.second.getOutline();
-            for (int i = 0; i < polygon->getNumPoints(); ++i)
-            {
-                polygon->setPoint(i, omnetpp::cFigure::Point { outline[i].x.value(), outline[i].y.value() });
-            }
-        }
+    if (!mVehicleGroup || !mVehicleIndex || !mVehiclesDirty) {
+        return;
     }
 
-    // remove all previous rays
-    for (int i = mRaysGroup->getNumFigures() - 1; i >= 0; --i)
+    int figureIndex = 0;
+    for (auto& name_vehicle : mVehicleIndex->getVehicles())
     {
-        delete mRaysGroup->removeFigure(i);
+        auto polygon = figures::recycle<omnetpp::cPolygonFigure>(mVehicleGroup, figureIndex++);
+        polygon->setName(name_vehicle.first.c_str());
+        polygon->setLineColor(omnetpp::cFigure::BLUE);
+        figures::assignPoints(polygon, name_vehicle.second.getOutline());
     }
+    figures::hideRemaining(mVehicleGroup, figureIndex);
+    mVehiclesDirty = false;
 }
 
 void Visualizer::drawReflectionRays(const Position& tx, const Position& rx,
@@ -131,37 +114,44 @@ void Visualizer::drawFoliageRay(const Position& tx, const Position& rx, const st
     const Position* start = &tx;
     for (const Position& point : foliage)
     {
-        auto figure = new omnetpp::cLineFigure();
-        mRaysGroup->addFigure(figure);
-        figure->setLineColor(isOutside ? mFoliageColorOutside : mFoliageColorInside);
-        figure->setStart(omnetpp::cFigure::Point { start->x.value(), start->y.value() });
-        figure->setEnd(omnetpp::cFigure::Point { point.x.value(), point.y.value() });
+        drawRay(start, &point, isOutside ? mFoliageColorOutside : mFoliageColorInside);
         start = &point;
         isOutside = !isOutside;
     }
 
-    auto figure = new omnetpp::cLineFigure();
-    mRaysGroup->addFigure(figure);
-    figure->setLineColor(mFoliageColorOutside);
-    figure->setStart(omnetpp::cFigure::Point { start->x.value(), start->y.value() });
-    figure->setEnd(omnetpp::cFigure::Point { rx.x.value(), rx.y.value() });
+    drawRay(start, &rx, mFoliageColorOutside);
 }
 
 void Visualizer::drawRays(const Position& tx, const Position& rx,
-        const std::vector<Position>& points, omnetpp::cFigure::Color c) const
+        const std::vector<Position>& points, omnetpp::cFigure::Color c)
 {
-    const omnetpp::cFigure::Point begin { tx.x.value(), tx.y.value() };
-    const omnetpp::cFigure::Point end { rx.x.value(), rx.y.value() };
+    if (!mRaysGroup) {
+        return;
+    }
 
     for (auto& point : points)
     {
-        auto figure = new omnetpp::cPolylineFigure();
-        mRaysGroup->addFigure(figure);
+        auto figure = figures::recycle<omnetpp::cPolylineFigure>(mRaysGroup, mNumRays++);
         figure->setLineColor(c);
-        figure->addPoint(begin);
-        figure->addPoint(omnetpp::cFigure::Point { point.x.value(), point.y.value() });
-        figure->addPoint(end);
+        figures::assignPoints(figure, std::array<Position, 3> {{ tx, point, rx }});
+    }
+}
+
+void Visualizer::drawRay(const Position* begin, const Position* end, omnetpp::cFigure::Color c)
+{
+    if (!mRaysGroup) {
+        return;
     }
+
+    auto figure = figures::recycle<omnetpp::cPolylineFigure>(mRaysGroup, mNumRays++);
+    figure->setLineColor(c);
+    figures::assignPoints(figure, std::array<Position, 2> {{ *begin, *end }});
+}
+
+Visualizer* findVisualizer(omnetpp::cModule* module)
+{
+    auto visualizer = inet::findModuleFromPar<Visualizer>(module->par("visualizerModule"), module, false);
+    return visualizer && visualizer->hasGUI() ? visualizer : nullptr;
 }
 
 } // namespace gemv2
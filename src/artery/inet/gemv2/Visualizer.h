@@ -20,6 +20,7 @@ class Visualizer : public omnetpp::cSimpleModule
 {
 public:
     void initialize(int stage) override;
+    void refreshDisplay() const override;
 
     void drawObstacles(const ObstacleIndex*);
     void drawVehicles(const VehicleIndex*);
@@ -30,13 +31,16 @@ public:
 
 protected:
     omnetpp::cGroupFigure* getObstacleGroup(const omnetpp::cModule*);
-    void drawRays(const Position&, const Position&, const std::vector<Position>&, omnetpp::cFigure::Color) const;
+    void drawRays(const Position&, const Position&, const std::vector<Position>&, omnetpp::cFigure::Color);
+    void drawRay(const Position* begin, const Position* end, omnetpp::cFigure::Color);
 
 private:
-    omnetpp::cGroupFigure* mVehicleGroup;
-    omnetpp::cGroupFigure* mRaysGroup;
-    std::unordered_map<std::string, omnetpp::cPolygonFigure*> mVehiclePolygons;
+    omnetpp::cGroupFigure* mVehicleGroup = nullptr;
+    omnetpp::cGroupFigure* mRaysGroup = nullptr;
     std::unordered_map<int, omnetpp::cGroupFigure*> mObstacleGroups;
+    const VehicleIndex* mVehicleIndex = nullptr;
+    mutable bool mVehiclesDirty = false;
+    int mNumRays = 0;
 
     omnetpp::cFigure::Color mBackgroundColor;
     omnetpp::cFigure::Color mDiffractionColor;
@@ -46,6 +50,14 @@ private:
     omnetpp::cFigure::Color mReflectionColorVehicle;
 };
 
+/**
+ * Find visualizer referred by module's "visualizerModule" parameter
+ *
+ * \param module looking for a visualizer
+ * \return visualizer if available and GUI is present, otherwise nullptr
+ */
+Visualizer* findVisualizer(omnetpp::cModule* module);
+
 } // namespace gemv2
 } // namespace artery
 
@@ -117,7 +117,7 @@ void Router::handleMessage(omnetpp::cMessage* msg)
         Identity identity;
         identity.geonet.insert({mNetworkInterface, addr});
         emit(Identity::changeSignal, Identity::ChangeGeoNetAddress, &identity);
-        mNetworkInterface->channel = properties->ServingChannel;
+        mNetworkInterface->setChannel(properties->ServingChannel);
     } else {
         error("Do not know how to handle received message");
     }
@@ -1,47 +1,88 @@
 #include "artery/testbed/OtaIndicationQueue.h"
 #include "artery/testbed/OtaInterface.h"
+#include <omnetpp/cexception.h>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
 namespace artery
 {
 
-OtaIndicationQueue::OtaIndicationQueue(OtaInterface* interface) :
-    mOtaInterface(interface), mNotified(false)
+OtaIndicationQueue::OtaIndicationQueue(OtaInterface* interface, std::size_t capacity) :
+    mIndications(capacity), mEventFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+    mOtaInterface(interface), mDropped(0), mInjectionLatency("OTA injection latency")
 {
+    if (mEventFd < 0) {
+        throw omnetpp::cRuntimeError("Creation of eventfd for OtaIndicationQueue failed: %s", std::strerror(errno));
+    }
+}
+
+OtaIndicationQueue::~OtaIndicationQueue()
+{
+    mIndications.consume_all([](const Indication& ind) { delete ind.packet; });
+    close(mEventFd);
 }
 
 void OtaIndicationQueue::waitFor(std::chrono::microseconds waitFor)
 {
-    std::unique_lock<std::mutex> lock(mMutex);
-    if (mCondVar.wait_for(lock, waitFor, [this]{ return mNotified; })) {
-        // create sending event only if the physical twin has already been created
-        if (mOtaInterface->hasRegisteredModule()) {
-            for (auto& ind : mIndicationList) {
-                mOtaInterface->receiveMessage(std::move(ind));
+    using namespace std::chrono;
+    const auto deadline = Clock::now() + waitFor;
+    auto remaining = duration_cast<nanoseconds>(waitFor);
+
+    while (remaining > nanoseconds::zero()) {
+        struct pollfd pfd = { mEventFd, POLLIN, 0 };
+        struct timespec timeout;
+        timeout.tv_sec = duration_cast<seconds>(remaining).count();
+        timeout.tv_nsec = (remaining - seconds(timeout.tv_sec)).count();
+
+        int ready = ppoll(&pfd, 1, &timeout, nullptr);
+        if (ready > 0) {
+            std::uint64_t counter;
+            if (read(mEventFd, &counter, sizeof(counter)) < 0 && errno != EAGAIN) {
+                throw omnetpp::cRuntimeError("Reading eventfd of OtaIndicationQueue failed: %s", std::strerror(errno));
+            }
+            if (drain() > 0) {
+                break;
             }
+        } else if (ready < 0 && errno != EINTR) {
+            throw omnetpp::cRuntimeError("Polling eventfd of OtaIndicationQueue failed: %s", std::strerror(errno));
         }
-        mIndicationList.clear();
-        mNotified = false;
+
+        remaining = duration_cast<nanoseconds>(deadline - Clock::now());
     }
 }
 
 void OtaIndicationQueue::trigger(std::unique_ptr<GeoNetPacket> ind)
 {
-    std::lock_guard<std::mutex> lock(mMutex);
-    mIndicationList.emplace_back(std::move(ind));
-    mNotified = true;
-    mCondVar.notify_one();
+    if (mIndications.push(Indication { ind.get(), Clock::now() })) {
+        ind.release();
+        const std::uint64_t one = 1;
+        ssize_t written = write(mEventFd, &one, sizeof(one));
+        (void) written; // eventfd counter saturation still leaves it readable
+    } else {
+        mDropped.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
 void OtaIndicationQueue::flushQueue()
 {
-    std::lock_guard<std::mutex> lock(mMutex);
-    if (mOtaInterface->hasRegisteredModule()) {
-        for (auto& ind : mIndicationList) {
-            mOtaInterface->receiveMessage(std::move(ind));
+    drain();
+}
+
+std::size_t OtaIndicationQueue::drain()
+{
+    // create sending event only if the physical twin has already been created
+    const bool inject = mOtaInterface->hasRegisteredModule();
+    return mIndications.consume_all([this, inject](const Indication& ind) {
+        std::unique_ptr<GeoNetPacket> packet { ind.packet };
+        if (inject) {
+            mOtaInterface->receiveMessage(std::move(packet));
+            mInjectionLatency.collect(std::chrono::duration<double>(Clock::now() - ind.arrival).count());
         }
-    }
-    mIndicationList.clear();
-    mNotified = false;
+    });
 }
 
 } // namespace artery
@@ -8,10 +8,11 @@
 #define ARTERY_OTA_INDICATION_QUEUE_H
 
 #include "artery/networking/GeoNetPacket.h"
+#include <boost/lockfree/spsc_queue.hpp>
+#include <omnetpp/chistogram.h>
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
-#include <mutex>
-#include <vector>
+#include <memory>
 
 namespace artery
 {
@@ -20,19 +21,34 @@ class OtaInterface;
 
 /**
  * The OtaIndicationQueue can be used to dispatch messages between an OtaInterface and an OMNeT++ scheduler
+ *
+ * Indications are passed through a bounded single-producer/single-consumer ring buffer:
+ * the producer is the thread receiving from the OTA hardware, the consumer is the scheduler.
+ * The scheduler sleeps on an eventfd which is signalled by the producer after each push.
  */
 class OtaIndicationQueue
 {
 public:
-    OtaIndicationQueue(OtaInterface* interface);
+    static constexpr std::size_t DefaultCapacity = 1024;
+
+    OtaIndicationQueue(OtaInterface* interface, std::size_t capacity = DefaultCapacity);
+    OtaIndicationQueue(const OtaIndicationQueue&) = delete;
+    OtaIndicationQueue& operator=(const OtaIndicationQueue&) = delete;
+    virtual ~OtaIndicationQueue();
 
     /**
      * Called by the scheduler to wait for the next event
+     *
+     * Returns when the given duration has elapsed, or earlier as soon as at least one
+     * indication has been injected. Interrupted polls and wake-ups without pending
+     * indications continue waiting for the remaining duration.
+     * \param duration maximum waiting time
      */
     virtual void waitFor(std::chrono::microseconds);
 
     /**
      * Called by the OtaInterface when a new GeoNetPacket must be scheduled by OMNeT++
+     * Never blocks: the packet is dropped if the queue is full
      * \param GeoNetPacket to send
      */
     virtual void trigger(std::unique_ptr<GeoNetPacket>);
@@ -42,15 +58,38 @@ public:
      */
     virtual void flushQueue();
 
+    /**
+     * Latency between arrival at the queue and injection into the simulation (seconds)
+     */
+    const omnetpp::cHistogram& getInjectionLatency() const { return mInjectionLatency; }
+
+    /**
+     * Number of indications dropped because the queue was full
+     */
+    unsigned long getDropped() const { return mDropped.load(std::memory_order_relaxed); }
+
 private:
-    std::condition_variable mCondVar;
-    std::vector<std::unique_ptr<GeoNetPacket>> mIndicationList;
-    std::mutex mMutex;
+    using Clock = std::chrono::steady_clock;
+
+    struct Indication
+    {
+        GeoNetPacket* packet;
+        Clock::time_point arrival;
+    };
+
+    /**
+     * Injects all queued indications into the simulation
+     * \return number of drained indications
+     */
+    std::size_t drain();
+
+    boost::lockfree::spsc_queue<Indication> mIndications;
+    int mEventFd;
     OtaInterface* mOtaInterface;
-    bool mNotified;
+    std::atomic<unsigned long> mDropped;
+    omnetpp::cHistogram mInjectionLatency;
 };
 
 } // namespace artery
 
 #endif /* ARTERY_OTA_INDICATION_QUEUE_H */
-
@@ -46,7 +46,7 @@ void OtaInterfaceUsrp::initialize(int stage)
     if(stage == 0) {
         mFakeMode = par("fakeMode");
 
-        mOtaIndicationQueue.reset(new OtaIndicationQueue(this));
+        mOtaIndicationQueue.reset(new OtaIndicationQueue(this, par("indicationQueueCapacity").intValue()));
         auto scheduler = dynamic_cast<TestbedScheduler*>(omnetpp::getSimulation()->getScheduler());
         if(!scheduler) {
             throw omnetpp::cRuntimeError("Testbed requires TestbedScheduler!");
@@ -117,6 +117,11 @@ void OtaInterfaceUsrp::finish()
 {
     EV_INFO << "Messages from DUT: " << mMessagesFromDut << std::endl;
     EV_INFO << "Messages to DUT: " << mMessagesToDut << std::endl;
+    recordScalar("messagesFromDut", mMessagesFromDut);
+    recordScalar("messagesToDut", mMessagesToDut);
+    recordScalar("droppedIndications", mOtaIndicationQueue->getDropped());
+    omnetpp::cHistogram latency = mOtaIndicationQueue->getInjectionLatency();
+    recordStatistic(&latency, "s");
     mConnection->shutDownConnection();
 }
 
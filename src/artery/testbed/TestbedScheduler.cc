@@ -20,13 +20,16 @@ void TestbedScheduler::startRun()
     omnetpp::cConfiguration *config = omnetpp::getEnvir()->getConfig();
     mThresholdTooSlow = std::chrono::milliseconds(config->getAsInt(CFG_SIMULATION_TOO_SLOW));
     mStartupTime = config->getAsDouble(CFG_STARTUP_TIME);
-    mBaseTime = std::chrono::system_clock::now();
+    mBaseTime = std::chrono::steady_clock::now();
+    mOptions = RealtimeOptions::fromConfiguration(config);
+    mStatistics.reset();
+    mCatchUp = 0;
 }
 
 void TestbedScheduler::executionResumed()
 {
     using namespace std::chrono;
-    mBaseTime = system_clock::now() - microseconds(omnetpp::simTime().inUnit(omnetpp::SIMTIME_US));
+    mBaseTime = steady_clock::now() - microseconds(omnetpp::simTime().inUnit(omnetpp::SIMTIME_US));
 }
 
 void TestbedScheduler::putBackEvent(omnetpp::cEvent* event)
@@ -46,6 +49,7 @@ omnetpp::cEvent* TestbedScheduler::guessNextEvent()
 omnetpp::cEvent* TestbedScheduler::takeNextEvent()
 {
     using namespace omnetpp;
+    mStatistics.enterScheduler(std::chrono::steady_clock::now());
     cEvent* init = peekFirstNonStaleEvent();
     cEvent* after = init;
     do {
@@ -56,25 +60,48 @@ omnetpp::cEvent* TestbedScheduler::takeNextEvent()
 
     cEvent* next = sim->getFES()->removeFirst();
     ASSERT(!next->isStale());
+    const auto now = std::chrono::steady_clock::now();
+    mStatistics.leaveScheduler(now, now - deadline(next));
     return next;
 }
 
 void TestbedScheduler::doTiming(omnetpp::cEvent* event)
 {
     using namespace std::chrono;
-    auto arrival = mBaseTime + microseconds(event->getArrivalTime().inUnit(omnetpp::SIMTIME_US));
-    auto waitFor = arrival - system_clock::now();
+    auto arrival = deadline(event);
+    auto waitFor = arrival - steady_clock::now();
 
-    if (mOtaIndicationQueue && waitFor >= system_clock::duration::zero()) {
+    if (mOtaIndicationQueue && waitFor >= steady_clock::duration::zero()) {
+        mCatchUp = 0;
         mOtaIndicationQueue->flushQueue();
-        waitFor = arrival - system_clock::now(); /*< update because of flushQueue's execution duration */
-        mOtaIndicationQueue->waitFor(duration_cast<microseconds>(waitFor));
-    } else if ((omnetpp::simTime() > mStartupTime) && (-waitFor > mThresholdTooSlow)) {
-        int tooSlow_ms = duration_cast<milliseconds>(mThresholdTooSlow).count();
-        int waitFor_ms = duration_cast<milliseconds>(waitFor).count();
-        omnetpp::cRuntimeError("Simulation too far behind real-time. "
-                "Maximum is set to %d milliseconds, but simulation lags behind %d milliseconds",
-                tooSlow_ms, waitFor_ms);
+        waitFor = arrival - steady_clock::now(); /*< update because of flushQueue's execution duration */
+        if (waitFor <= mOptions.busyPoll) {
+            // spin until deadline is reached or an injected indication has preceded the event
+            while (steady_clock::now() < arrival && sim->getFES()->peekFirst() == event) {
+                mOtaIndicationQueue->flushQueue();
+            }
+        } else {
+            mOtaIndicationQueue->waitFor(duration_cast<microseconds>(waitFor));
+        }
+    } else if (waitFor < steady_clock::duration::zero()) {
+        if (mOtaIndicationQueue && mOptions.catchUpLimit > 0) {
+            // overdue events are dispatched back-to-back, but do not starve indications from DUT
+            if (mCatchUp < mOptions.catchUpLimit) {
+                ++mCatchUp;
+                mStatistics.countCatchUp();
+            } else {
+                mOtaIndicationQueue->flushQueue();
+                mCatchUp = 0;
+            }
+        }
+
+        if ((omnetpp::simTime() > mStartupTime) && (-waitFor > mThresholdTooSlow)) {
+            int tooSlow_ms = duration_cast<milliseconds>(mThresholdTooSlow).count();
+            int waitFor_ms = duration_cast<milliseconds>(-waitFor).count();
+            throw omnetpp::cRuntimeError("Simulation too far behind real-time. "
+                    "Maximum is set to %d milliseconds, but simulation lags behind %d milliseconds",
+                    tooSlow_ms, waitFor_ms);
+        }
     }
 }
 
@@ -95,6 +122,19 @@ omnetpp::cEvent* TestbedScheduler::peekFirstNonStaleEvent()
     return event;
 }
 
+std::chrono::steady_clock::time_point TestbedScheduler::deadline(const omnetpp::cEvent* event) const
+{
+    return mBaseTime + std::chrono::microseconds(event->getArrivalTime().inUnit(omnetpp::SIMTIME_US));
+}
+
+void TestbedScheduler::lifecycleEvent(omnetpp::SimulationLifecycleEventType type, omnetpp::cObject* details)
+{
+    if (type == omnetpp::LF_PRE_NETWORK_FINISH) {
+        mStatistics.record(sim->getSystemModule(), "testbedScheduler");
+    }
+    omnetpp::cScheduler::lifecycleEvent(type, details);
+}
+
 void TestbedScheduler::setOtaIndicationQueue(std::shared_ptr<OtaIndicationQueue> queue)
 {
     mOtaIndicationQueue = queue;
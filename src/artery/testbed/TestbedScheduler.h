@@ -7,6 +7,7 @@
 #ifndef ARTERY_TESTBEDSCHEDULER_H_NJ0QMNVB
 #define ARTERY_TESTBEDSCHEDULER_H_NJ0QMNVB
 
+#include "artery/utility/RealtimeStatistics.h"
 #include <omnetpp/cscheduler.h>
 #include <omnetpp/simtime.h>
 #include <chrono>
@@ -26,17 +27,24 @@ public:
     omnetpp::cEvent* guessNextEvent() override;
     void putBackEvent(omnetpp::cEvent*) override;
 
+    void lifecycleEvent(omnetpp::SimulationLifecycleEventType, omnetpp::cObject*) override;
+
     virtual void setOtaIndicationQueue(std::shared_ptr<OtaIndicationQueue>);
+    const RealtimeStatistics& getStatistics() const { return mStatistics; }
 
 protected:
     virtual void doTiming(omnetpp::cEvent*);
     omnetpp::cEvent* peekFirstNonStaleEvent();
+    std::chrono::steady_clock::time_point deadline(const omnetpp::cEvent*) const;
 
 private:
     std::shared_ptr<OtaIndicationQueue> mOtaIndicationQueue = nullptr;
-    std::chrono::system_clock::time_point mBaseTime;
-    std::chrono::system_clock::duration mThresholdTooSlow;
+    std::chrono::steady_clock::time_point mBaseTime;
+    std::chrono::steady_clock::duration mThresholdTooSlow;
     omnetpp::simtime_t mStartupTime;
+    RealtimeOptions mOptions;
+    RealtimeStatistics mStatistics;
+    unsigned mCatchUp = 0;
 };
 
 } // namespace artery
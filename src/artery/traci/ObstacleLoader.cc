@@ -0,0 +1,135 @@
+#include "artery/traci/ObstacleLoader.h"
+#include "artery/traci/PolygonSet.h"
+#include "traci/API.h"
+#include "traci/Boundary.h"
+#include <boost/algorithm/string/classification.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <boost/geometry.hpp>
+#include <omnetpp/ccomponent.h>
+#include <omnetpp/cexception.h>
+#include <omnetpp/clog.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace artery
+{
+
+namespace
+{
+
+std::uint64_t snapshotKey(const traci::API& traci, const ObstacleFilter& filter, const ObstacleSnapshotFile& file)
+{
+    SnapshotKey key;
+    key.add(&ObstacleSnapshot::Version, sizeof(ObstacleSnapshot::Version));
+    // outlines are stored in Artery's coordinate system, which depends on the network boundary
+    const traci::Boundary boundary { traci.simulation.getNetBoundary() };
+    const double corners[] = {
+        boundary.lowerLeftPosition().x, boundary.lowerLeftPosition().y,
+        boundary.upperRightPosition().x, boundary.upperRightPosition().y
+    };
+    key.add(corners, sizeof(corners));
+    for (const std::string& type : filter.types) {
+        key.add(type);
+    }
+    const char filled = filter.requireFilled ? 1 : 0;
+    key.add(&filled, sizeof(filled));
+    for (const std::string& source : file.sources) {
+        key.addFile(source);
+    }
+    return key.value();
+}
+
+} // namespace
+
+std::shared_ptr<const ObstacleSnapshot> buildObstacles(const PolygonSet& polygons, const ObstacleFilter& filter,
+        std::uint64_t key)
+{
+    ObstacleSnapshot::Builder builder;
+    unsigned ignored = 0;
+    std::string invalid;
+    for (const PolygonSet::Polygon& polygon : polygons.polygons) {
+        if (!filter.types.empty() && filter.types.find(polygon.type) == filter.types.end()) {
+            EV_DEBUG << "ignore polygon " << polygon.id << " of type " << polygon.type << "\n";
+            ++ignored;
+            continue;
+        } else if (filter.requireFilled && !polygon.filled) {
+            EV_DEBUG << "ignore unfilled polygon " << polygon.id << "\n";
+            ++ignored;
+            continue;
+        }
+
+        std::vector<Position> shape = polygon.shape;
+        boost::geometry::correct(shape); // fixes issues such as reversed point order
+        if (!boost::geometry::is_valid(shape, invalid)) {
+            EV_DEBUG << "ignore invalid polygon " << polygon.id << " (" << invalid << ")\n";
+            ++ignored;
+            continue;
+        }
+
+        std::vector<ObstacleSnapshot::Point> outline;
+        outline.reserve(shape.size());
+        for (const Position& point : shape) {
+            outline.push_back(ObstacleSnapshot::Point { point.x.value(), point.y.value() });
+        }
+        builder.add(polygon.id, polygon.type, std::move(outline), polygon.filled ? ObstacleSnapshot::Filled : 0);
+    }
+
+    auto snapshot = builder.build(key);
+    EV_INFO << snapshot->size() << " obstacles built from polygons (" << ignored << " ignored)\n";
+    return snapshot;
+}
+
+ObstacleSnapshotFile ObstacleSnapshotFile::fromParameters(omnetpp::cComponent& component)
+{
+    ObstacleSnapshotFile file;
+    file.path = component.par("obstacleSnapshot").stdstringValue();
+    const std::string sources = component.par("obstacleSnapshotSources").stdstringValue();
+    boost::split(file.sources, sources, boost::is_any_of(" "), boost::token_compress_on);
+    file.sources.erase(std::remove(file.sources.begin(), file.sources.end(), std::string()), file.sources.end());
+    if (!file.path.empty() && file.sources.empty()) {
+        throw omnetpp::cRuntimeError("obstacleSnapshot requires obstacleSnapshotSources, e.g. the SUMO poly file");
+    }
+    return file;
+}
+
+std::shared_ptr<const ObstacleSnapshot> loadObstacles(const traci::API& traci, const ObstacleFilter& filter,
+        const ObstacleSnapshotFile& file)
+{
+    if (file.path.empty()) {
+        return buildObstacles(*fetchPolygonSet(traci, filter.types), filter);
+    }
+
+    if (file.sources.empty()) {
+        throw omnetpp::cRuntimeError("Obstacle snapshot %s requires source files, e.g. the SUMO poly file",
+                file.path.c_str());
+    }
+
+    std::uint64_t key = 0;
+    try {
+        key = snapshotKey(traci, filter, file);
+    } catch (const std::runtime_error& e) {
+        throw omnetpp::cRuntimeError("Obstacle snapshot %s: %s", file.path.c_str(), e.what());
+    }
+
+    try {
+        auto snapshot = ObstacleSnapshot::map(file.path, key);
+        if (snapshot) {
+            EV_INFO << snapshot->size() << " obstacles mapped from snapshot " << file.path << "\n";
+            return snapshot;
+        }
+        EV_INFO << "obstacle snapshot " << file.path << " is missing or stale\n";
+    } catch (const std::runtime_error& e) {
+        EV_WARN << "ignore obstacle snapshot: " << e.what() << "\n";
+    }
+
+    auto snapshot = buildObstacles(*fetchPolygonSet(traci, filter.types), filter, key);
+    try {
+        snapshot->write(file.path);
+        EV_INFO << "obstacle snapshot " << file.path << " written\n";
+    } catch (const std::runtime_error& e) {
+        EV_WARN << e.what() << "\n";
+    }
+    return snapshot;
+}
+
+} // namespace artery
@@ -0,0 +1,73 @@
+#ifndef ARTERY_OBSTACLELOADER_H_JX2M5QFA
+#define ARTERY_OBSTACLELOADER_H_JX2M5QFA
+
+#include "artery/utility/ObstacleSnapshot.h"
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+// forward declarations
+namespace omnetpp { class cComponent; }
+namespace traci { class API; }
+
+namespace artery
+{
+
+struct PolygonSet;
+
+/**
+ * Selection of SUMO polygons considered as obstacles
+ */
+struct ObstacleFilter
+{
+    std::set<std::string> types; /*< accepted polygon types, all types if empty */
+    bool requireFilled = false;
+};
+
+/**
+ * Optional snapshot file for loading obstacles without TraCI queries
+ */
+struct ObstacleSnapshotFile
+{
+    /**
+     * Read snapshot file from component's obstacleSnapshot and obstacleSnapshotSources parameters
+     */
+    static ObstacleSnapshotFile fromParameters(omnetpp::cComponent&);
+
+    std::string path; /*< snapshot file, snapshots are disabled if empty */
+    std::vector<std::string> sources; /*< files whose contents key the snapshot, e.g. SUMO poly files */
+};
+
+/**
+ * Build obstacles from polygons passing the filter
+ *
+ * Obstacle outlines are corrected and invalid outlines are dropped.
+ * \param polygons polygon set, e.g. fetched via TraCI
+ * \param filter obstacle selection
+ * \param key snapshot key
+ * \return obstacles, never nullptr
+ */
+std::shared_ptr<const ObstacleSnapshot> buildObstacles(const PolygonSet& polygons, const ObstacleFilter& filter,
+        std::uint64_t key = 0);
+
+/**
+ * Load obstacles passing the filter
+ *
+ * Obstacle outlines are corrected and invalid outlines are dropped. If a snapshot file is given
+ * and its key matches the network boundary, filter and source files, obstacles are memory-mapped
+ * from this file. Otherwise, obstacles are fetched via TraCI and the snapshot file is (re-)written.
+ *
+ * \param traci API of connected SUMO instance
+ * \param filter obstacle selection
+ * \param file snapshot file
+ * \return obstacles, never nullptr
+ * \throw omnetpp::cRuntimeError if snapshot file is given without source files
+ */
+std::shared_ptr<const ObstacleSnapshot> loadObstacles(const traci::API&, const ObstacleFilter&,
+        const ObstacleSnapshotFile& file = ObstacleSnapshotFile());
+
+} // namespace artery
+
+#endif /* ARTERY_OBSTACLELOADER_H_JX2M5QFA */
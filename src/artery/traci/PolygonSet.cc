@@ -0,0 +1,91 @@
+#include "artery/traci/PolygonSet.h"
+#include "artery/traci/Cast.h"
+#include "artery/utility/ObstacleSnapshot.h"
+#include "traci/API.h"
+#include <omnetpp/cexception.h>
+#include <sstream>
+#include <stdexcept>
+
+namespace artery
+{
+
+namespace
+{
+
+std::ostringstream& startKey(std::ostringstream& key, const traci::API& traci)
+{
+    const traci::Boundary boundary { traci.simulation.getNetBoundary() };
+    key.precision(17);
+    key << "traci.polygons/" << boundary.lowerLeftPosition().x << "," << boundary.lowerLeftPosition().y;
+    key << "," << boundary.upperRightPosition().x << "," << boundary.upperRightPosition().y;
+    return key;
+}
+
+} // namespace
+
+std::shared_ptr<const PolygonSet> fetchPolygonSet(const traci::API& traci, const std::set<std::string>& types)
+{
+    const auto& polygons = traci.polygon;
+    const traci::Boundary boundary { traci.simulation.getNetBoundary() };
+    const std::vector<std::string> ids = polygons.getIDList();
+
+    auto set = std::make_shared<PolygonSet>();
+    for (const std::string& id : ids) {
+        PolygonSet::Polygon polygon;
+        polygon.id = id;
+        polygon.type = polygons.getType(id);
+        if (!types.empty() && types.find(polygon.type) == types.end()) {
+            continue;
+        }
+
+        polygon.filled = polygons.getFilled(id);
+        for (const traci::TraCIPosition& point : polygons.getShape(id).value) {
+            polygon.shape.push_back(traci::position_cast(boundary, point));
+        }
+        set->polygons.push_back(std::move(polygon));
+    }
+    return set;
+}
+
+std::string getPolygonSetKey(const traci::API& traci, const PolygonSet& set)
+{
+    SnapshotKey content;
+    for (const PolygonSet::Polygon& polygon : set.polygons) {
+        content.add(polygon.id);
+        content.add(polygon.type);
+        const char filled = polygon.filled ? 1 : 0;
+        content.add(&filled, sizeof(filled));
+        for (const Position& point : polygon.shape) {
+            const double xy[] = { point.x.value(), point.y.value() };
+            content.add(xy, sizeof(xy));
+        }
+        const char separator = 0;
+        content.add(&separator, sizeof(separator));
+    }
+
+    std::ostringstream key;
+    startKey(key, traci) << "/content/" << set.polygons.size() << "/" << std::hex << content.value();
+    return key.str();
+}
+
+std::string getPolygonSetKey(const traci::API& traci, const std::vector<std::string>& sources)
+{
+    SnapshotKey content;
+    for (const std::string& id : traci.polygon.getIDList()) {
+        content.add(id);
+    }
+    try {
+        for (const std::string& source : sources) {
+            content.add(source);
+            content.addFile(source);
+        }
+    } catch (const std::runtime_error& e) {
+        throw omnetpp::cRuntimeError("Polygon set key: %s", e.what());
+    }
+
+    std::ostringstream key;
+    startKey(key, traci) << "/sources/" << std::hex << content.value();
+    return key.str();
+}
+
+} // namespace artery
@@ -0,0 +1,69 @@
+#ifndef ARTERY_POLYGONSET_H_R7KQ2WNE
+#define ARTERY_POLYGONSET_H_R7KQ2WNE
+
+#include "artery/utility/Geometry.h"
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+// forward declaration
+namespace traci { class API; }
+
+namespace artery
+{
+
+/**
+ * PolygonSet holds polygons of a SUMO scenario in Artery's coordinate system
+ */
+struct PolygonSet
+{
+    struct Polygon
+    {
+        std::string id;
+        std::string type;
+        bool filled;
+        std::vector<Position> shape;
+    };
+
+    std::vector<Polygon> polygons;
+};
+
+/**
+ * Fetch polygons via TraCI
+ *
+ * Only the type of each polygon is queried for polygons of other types.
+ * Polygon sets are not retained, i.e. obstacles derived from them should be shared instead.
+ * \param traci API of connected SUMO instance
+ * \param types fetch only polygons of these types, all polygons if empty
+ * \return polygon set, never nullptr
+ */
+std::shared_ptr<const PolygonSet> fetchPolygonSet(const traci::API&, const std::set<std::string>& types = {});
+
+/**
+ * Key identifying polygons by their content
+ *
+ * The key covers network boundary, ids, types, filled flags and shapes of all polygons in the set.
+ * Computing it requires a fetched set, i.e. per-polygon TraCI queries even if artefacts derived
+ * from these polygons are already shared. Prefer the key of source files if they are known.
+ * \param traci API of connected SUMO instance
+ * \param polygons polygon set fetched from this instance
+ * \return key suitable for shared artefacts derived from these polygons
+ */
+std::string getPolygonSetKey(const traci::API&, const PolygonSet& polygons);
+
+/**
+ * Key identifying polygons by the files SUMO has loaded them from
+ *
+ * The key covers network boundary, polygon ids and the contents of the given files,
+ * i.e. polygon shapes are not fetched for this key.
+ * \param traci API of connected SUMO instance
+ * \param sources files polygons are loaded from, e.g. SUMO poly files
+ * \return key suitable for shared artefacts derived from polygons
+ * \throw omnetpp::cRuntimeError if a source file cannot be read
+ */
+std::string getPolygonSetKey(const traci::API&, const std::vector<std::string>& sources);
+
+} // namespace artery
+
+#endif /* ARTERY_POLYGONSET_H_R7KQ2WNE */
@@ -0,0 +1,211 @@
+#include "artery/traci/StaticObstacles.h"
+#include "artery/traci/PolygonSet.h"
+#include "artery/utility/SharedArtefacts.h"
+#include <boost/geometry.hpp>
+#include <omnetpp/cexception.h>
+#include <omnetpp/clog.h>
+#include <algorithm>
+
+namespace artery
+{
+
+namespace
+{
+
+using TypeSet = std::set<std::string>;
+
+} // namespace
+
+StaticObstacle::StaticObstacle(std::string id, std::vector<Position> outline, bool filled) :
+    mId(std::move(id)), mOutline(std::move(outline)),
+    mBoundingBox(boost::geometry::return_envelope<geometry::Box>(mOutline)),
+    mCentroid(boost::geometry::return_centroid<Position>(mOutline)),
+    mArea(boost::geometry::area(mOutline)),
+    mFilled(filled)
+{
+}
+
+StaticObstacleLayer::StaticObstacleLayer(std::string type, const ObstacleSnapshot& snapshot,
+        const std::vector<std::size_t>& members) :
+    mType(std::move(type))
+{
+    std::vector<RtreeValue> values;
+    values.reserve(members.size());
+    mObstacles.reserve(members.size());
+    for (std::size_t i : members) {
+        auto points = snapshot.outline(i);
+        std::vector<Position> outline;
+        outline.reserve(points.second - points.first);
+        for (auto point = points.first; point != points.second; ++point) {
+            outline.emplace_back(point->x, point->y);
+        }
+
+        auto obstacle = std::make_shared<StaticObstacle>(snapshot.id(i), std::move(outline), snapshot.filled(i));
+        mIds.emplace(obstacle->getObstacleId(), mObstacles.size());
+        values.emplace_back(obstacle->getBoundingBox(), mObstacles.size());
+        mObstacles.push_back(std::move(obstacle));
+    }
+
+    // bulk loading of obstacles for efficient packing
+    mRtree = Rtree { values };
+}
+
+StaticObstacleLayer::Handle StaticObstacleLayer::find(const std::string& id) const
+{
+    auto found = mIds.find(id);
+    return found != mIds.end() ? &mObstacles[found->second] : nullptr;
+}
+
+StaticObstacleView::StaticObstacleView(std::vector<Layer> layers, bool requireFilled) :
+    mLayers(std::move(layers)), mRequireFilled(requireFilled)
+{
+    forEach([this](const std::shared_ptr<StaticObstacle>&) { ++mSize; });
+}
+
+StaticObstacleView::Handle StaticObstacleView::find(const std::string& id) const
+{
+    for (const Layer& layer : mLayers) {
+        Handle handle = layer->find(id);
+        if (handle && (!mRequireFilled || (*handle)->isFilled())) {
+            return handle;
+        }
+    }
+    return nullptr;
+}
+
+StaticObstacles& StaticObstacles::instance()
+{
+    static StaticObstacles obstacles;
+    return obstacles;
+}
+
+void StaticObstacles::expire()
+{
+    std::string run = SharedArtefacts::getRunId();
+    if (run != mRunId) {
+        mTypes.clear();
+        mAllTypes = false;
+        mSnapshotFile = ObstacleSnapshotFile();
+        mScenario.clear();
+        mPolygons.reset();
+        mRunId = std::move(run);
+    }
+}
+
+void StaticObstacles::announce(const ObstacleFilter& filter, const ObstacleSnapshotFile& file)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    expire();
+
+    if (!file.path.empty()) {
+        if (mSnapshotFile.path.empty()) {
+            mSnapshotFile = file;
+        } else if (mSnapshotFile.path != file.path || mSnapshotFile.sources != file.sources) {
+            throw omnetpp::cRuntimeError("Static obstacles use snapshot %s already, %s conflicts with it",
+                    mSnapshotFile.path.c_str(), file.path.c_str());
+        }
+    }
+
+    mTypes.insert(filter.types.begin(), filter.types.end());
+    mAllTypes |= filter.types.empty();
+}
+
+StaticObstacleView StaticObstacles::getView(const traci::API& traci, const ObstacleFilter& filter)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    expire();
+
+    const bool announced = filter.types.empty() ? mAllTypes :
+        mAllTypes || std::includes(mTypes.begin(), mTypes.end(), filter.types.begin(), filter.types.end());
+    if (!announced) {
+        throw omnetpp::cRuntimeError("Static obstacle types have to be announced before requesting a view");
+    }
+
+    // polygons stay the same during a run, thus the scenario key is only computed by the first view
+    if (mScenario.empty()) {
+        if (!mSnapshotFile.sources.empty()) {
+            mScenario = getPolygonSetKey(traci, mSnapshotFile.sources);
+        } else {
+            // key covers polygon contents, keep fetched polygons for building missing partitions
+            mPolygons = fetchPolygonSet(traci, getSelection().types);
+            mScenario = getPolygonSetKey(traci, *mPolygons);
+        }
+        mScenario = "static-obstacles/" + mScenario + "/";
+    }
+
+    std::vector<StaticObstacleView::Layer> layers;
+    if (!collect(mScenario, filter.types, layers)) {
+        load(traci, mScenario);
+        layers.clear();
+        if (!collect(mScenario, filter.types, layers)) {
+            throw omnetpp::cRuntimeError("Static obstacles are missing after loading");
+        }
+    }
+    mPolygons.reset();
+
+    return StaticObstacleView { std::move(layers), filter.requireFilled };
+}
+
+ObstacleFilter StaticObstacles::getSelection() const
+{
+    // all types announced for this run are loaded at once, thus the snapshot's content is independent of module order
+    ObstacleFilter selection;
+    if (!mAllTypes) {
+        selection.types = mTypes;
+    }
+    // filled flags are kept per obstacle, views filter them on demand
+    selection.requireFilled = false;
+    return selection;
+}
+
+bool StaticObstacles::collect(const std::string& scenario, const std::set<std::string>& types,
+        std::vector<StaticObstacleView::Layer>& layers)
+{
+    SharedArtefacts& artefacts = SharedArtefacts::instance();
+    std::shared_ptr<const TypeSet> allTypes;
+    if (types.empty()) {
+        allTypes = artefacts.find<TypeSet>(scenario + "*");
+        if (!allTypes) {
+            return false;
+        }
+    }
+
+    for (const std::string& type : allTypes ? *allTypes : types) {
+        auto layer = artefacts.find<StaticObstacleLayer>(scenario + type);
+        if (!layer) {
+            return false;
+        }
+        layers.push_back(std::move(layer));
+    }
+    return true;
+}
+
+void StaticObstacles::load(const traci::API& traci, const std::string& scenario)
+{
+    const ObstacleFilter selection = getSelection();
+    auto snapshot = mPolygons ? buildObstacles(*mPolygons, selection) : loadObstacles(traci, selection, mSnapshotFile);
+    const auto& snapshotTypes = snapshot->types();
+    std::vector<std::vector<std::size_t>> members(snapshotTypes.size());
+    for (std::size_t i = 0; i < snapshot->size(); ++i) {
+        members[snapshot->type(i)].push_back(i);
+    }
+
+    SharedArtefacts& artefacts = SharedArtefacts::instance();
+    TypeSet types = selection.types;
+    if (types.empty()) {
+        types.insert(snapshotTypes.begin(), snapshotTypes.end());
+        artefacts.get<TypeSet>(scenario + "*", [&types]() { return std::make_shared<const TypeSet>(types); });
+    }
+
+    const std::vector<std::size_t> none;
+    for (const std::string& type : types) {
+        artefacts.get<StaticObstacleLayer>(scenario + type, [&]() {
+            auto found = std::find(snapshotTypes.begin(), snapshotTypes.end(), type);
+            const auto& indices = found != snapshotTypes.end() ? members[found - snapshotTypes.begin()] : none;
+            EV_INFO << indices.size() << " static obstacles of type \"" << type << "\" indexed\n";
+            return std::make_shared<const StaticObstacleLayer>(type, *snapshot, indices);
+        });
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,212 @@
+#ifndef ARTERY_STATICOBSTACLES_H_N5TB3XRC
+#define ARTERY_STATICOBSTACLES_H_N5TB3XRC
+
+#include "artery/traci/ObstacleLoader.h"
+#include "artery/traci/PolygonSet.h"
+#include "artery/utility/Geometry.h"
+#include <boost/geometry/index/rtree.hpp>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// forward declaration
+namespace traci { class API; }
+
+namespace artery
+{
+
+/**
+ * StaticObstacle is an immutable obstacle such as a building or a patch of foliage
+ */
+class StaticObstacle
+{
+public:
+    /**
+     * \param id obstacle id
+     * \param outline corrected and valid outline
+     * \param filled true if obstacle's polygon is filled
+     */
+    StaticObstacle(std::string id, std::vector<Position> outline, bool filled = true);
+
+    const std::string& getObstacleId() const { return mId; }
+    const std::vector<Position>& getOutline() const { return mOutline; }
+    const geometry::Box& getBoundingBox() const { return mBoundingBox; }
+    const Position& getCentroid() const { return mCentroid; }
+    double getArea() const { return mArea; }
+    bool isFilled() const { return mFilled; }
+
+private:
+    std::string mId;
+    std::vector<Position> mOutline;
+    geometry::Box mBoundingBox;
+    Position mCentroid;
+    double mArea;
+    bool mFilled;
+};
+
+/**
+ * StaticObstacleLayer holds all static obstacles of one type along with their R-tree
+ */
+class StaticObstacleLayer
+{
+public:
+    using Handle = const std::shared_ptr<StaticObstacle>*;
+    using RtreeValue = std::pair<geometry::Box, std::size_t>;
+    using Rtree = boost::geometry::index::rtree<RtreeValue, boost::geometry::index::rstar<16>>;
+
+    /**
+     * Build layer from snapshot
+     * \param type obstacle type of this layer
+     * \param snapshot loaded obstacles
+     * \param members indices of snapshot obstacles belonging to this layer
+     */
+    StaticObstacleLayer(std::string type, const ObstacleSnapshot& snapshot, const std::vector<std::size_t>& members);
+
+    const std::string& getType() const { return mType; }
+    const std::vector<std::shared_ptr<StaticObstacle>>& getObstacles() const { return mObstacles; }
+    const Rtree& getRtree() const { return mRtree; }
+
+    /**
+     * Find obstacle by its id
+     * \return handle or nullptr if this layer has no such obstacle
+     */
+    Handle find(const std::string& id) const;
+
+private:
+    std::string mType;
+    std::vector<std::shared_ptr<StaticObstacle>> mObstacles;
+    std::unordered_map<std::string, std::size_t> mIds;
+    Rtree mRtree;
+};
+
+/**
+ * StaticObstacleView selects layers of static obstacles
+ *
+ * Views are cheap to copy and keep their layers alive, i.e. obstacle handles
+ * stay valid as long as the view (or one of its copies) exists.
+ */
+class StaticObstacleView
+{
+public:
+    using Handle = StaticObstacleLayer::Handle;
+    using Layer = std::shared_ptr<const StaticObstacleLayer>;
+
+    StaticObstacleView() = default;
+    StaticObstacleView(std::vector<Layer> layers, bool requireFilled);
+
+    /**
+     * Visit obstacles whose bounding boxes satisfy an R-tree predicate
+     * \param predicate Boost.Geometry index predicate, e.g. intersects(box)
+     * \param visitor invoked with obstacle's shared pointer, returning false stops the query
+     * \return false if query has been stopped by visitor
+     */
+    template<typename P, typename F>
+    bool query(const P& predicate, F visitor) const
+    {
+        for (const Layer& layer : mLayers) {
+            const auto& obstacles = layer->getObstacles();
+            const auto& rtree = layer->getRtree();
+            for (auto it = rtree.qbegin(predicate); it != rtree.qend(); ++it) {
+                const std::shared_ptr<StaticObstacle>& obstacle = obstacles[it->second];
+                if ((!mRequireFilled || obstacle->isFilled()) && !visitor(obstacle)) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Visit all obstacles of this view
+     * \param visitor invoked with obstacle's shared pointer
+     */
+    template<typename F>
+    void forEach(F visitor) const
+    {
+        for (const Layer& layer : mLayers) {
+            for (const std::shared_ptr<StaticObstacle>& obstacle : layer->getObstacles()) {
+                if (!mRequireFilled || obstacle->isFilled()) {
+                    visitor(obstacle);
+                }
+            }
+        }
+    }
+
+    /**
+     * Find obstacle by its id
+     * \return handle or nullptr if no obstacle of this view has given id
+     */
+    Handle find(const std::string& id) const;
+
+    std::size_t size() const { return mSize; }
+    bool empty() const { return mSize == 0; }
+    const std::vector<Layer>& getLayers() const { return mLayers; }
+
+private:
+    std::vector<Layer> mLayers;
+    bool mRequireFilled = false;
+    std::size_t mSize = 0;
+};
+
+/**
+ * StaticObstacles provides static obstacles to all modules of a simulation
+ *
+ * Obstacles are partitioned by polygon type and each partition is built only once,
+ * i.e. modules asking for the same types (e.g. environment model and GEMV2) share
+ * outlines and R-trees. Partitions are kept as shared artefacts, thus they are also
+ * reused by later runs of the same process.
+ *
+ * Modules announce their obstacle types during initialization. When the first view is
+ * requested (usually on traci.init), all announced types are loaded at once, so a single
+ * snapshot file serves all modules.
+ */
+class StaticObstacles
+{
+public:
+    static StaticObstacles& instance();
+
+    /**
+     * Announce obstacles required by a module of the current run
+     * \param filter obstacle selection
+     * \param file snapshot file, all modules of a run have to agree on one file
+     * \throw omnetpp::cRuntimeError if snapshot file conflicts with previous announcements
+     */
+    void announce(const ObstacleFilter& filter, const ObstacleSnapshotFile& file);
+
+    /**
+     * Get view on obstacles, loads missing partitions
+     *
+     * Partitions are identified by the contents of the snapshot's source files if given,
+     * otherwise by the contents of the announced polygons fetched via TraCI. The latter
+     * queries the type of every polygon and shape and filled flag of each announced one
+     * once per run, even if all partitions are already shared by a previous run.
+     * Configure snapshot source files to avoid these per-polygon queries.
+     * \param traci API of connected SUMO instance
+     * \param filter obstacle selection, its types have to be announced
+     * \return view on obstacles
+     */
+    StaticObstacleView getView(const traci::API&, const ObstacleFilter& filter);
+
+private:
+    StaticObstacles() = default;
+    void expire();
+    bool collect(const std::string& scenario, const std::set<std::string>& types, std::vector<StaticObstacleView::Layer>&);
+    void load(const traci::API&, const std::string& scenario);
+    ObstacleFilter getSelection() const;
+
+    std::mutex mMutex;
+    std::string mRunId;
+    std::set<std::string> mTypes; /*< types announced for current run */
+    bool mAllTypes = false; /*< any module of current run requires obstacles of all types */
+    ObstacleSnapshotFile mSnapshotFile;
+    std::string mScenario; /*< key prefix of current run's partitions */
+    std::shared_ptr<const PolygonSet> mPolygons; /*< polygons fetched for content key */
+};
+
+} // namespace artery
+
+#endif /* ARTERY_STATICOBSTACLES_H_N5TB3XRC */
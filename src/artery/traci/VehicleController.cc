@@ -4,6 +4,7 @@
 #include <boost/units/systems/angle/degrees.hpp>
 #include <boost/units/systems/si/acceleration.hpp>
 #include <boost/units/systems/si/plane_angle.hpp>
+#include <boost/units/systems/si/time.hpp>
 #include <boost/units/systems/si/velocity.hpp>
 
 namespace si = boost::units::si;
@@ -49,9 +50,11 @@ artery::Position VehicleController::getPosition() const
 
 auto VehicleController::getGeoPosition() const -> artery::GeoPosition
 {
-    TraCIPosition traci_pos = m_cache->get<libsumo::VAR_POSITION>();
-
-    TraCIGeoPosition traci_geo = m_traci->convertGeo(traci_pos);
+    // use position projected by node manager's batch if available,
+    // requesting it includes this vehicle in the next batch
+    const TraCIGeoPosition* projected = m_cache->getGeoPosition();
+    TraCIGeoPosition traci_geo = projected ? *projected :
+        m_traci->convertGeo(m_cache->get<libsumo::VAR_POSITION>());
     artery::GeoPosition geo;
     geo.latitude = traci_geo.latitude * boost::units::degree::degree;
     geo.longitude = traci_geo.longitude * boost::units::degree::degree;
@@ -76,17 +79,34 @@ auto VehicleController::getMaxSpeed() const -> Velocity
 
 void VehicleController::setMaxSpeed(Velocity v)
 {
-    m_traci->vehicle.setMaxSpeed(m_cache->getId(), v / si::meter_per_second);
+    m_traci->queueDouble(libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::VAR_MAXSPEED, m_cache->getId(), v / si::meter_per_second);
 }
 
 void VehicleController::setSpeed(Velocity v)
 {
-    m_traci->vehicle.setSpeed(m_cache->getId(), v / si::meter_per_second);
+    m_traci->queueDouble(libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::VAR_SPEED, m_cache->getId(), v / si::meter_per_second);
 }
 
 void VehicleController::setSpeedFactor(double f)
 {
-    m_traci->vehicle.setSpeedFactor(m_cache->getId(), f);
+    m_traci->queueDouble(libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::VAR_SPEED_FACTOR, m_cache->getId(), f);
+}
+
+void VehicleController::setSpeedMode(int mode)
+{
+    m_traci->queueInt(libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::VAR_SPEEDSETMODE, m_cache->getId(), mode);
+}
+
+void VehicleController::slowDown(Velocity v, Duration d)
+{
+    tcpip::Storage content;
+    content.writeUnsignedByte(libsumo::TYPE_COMPOUND);
+    content.writeInt(2);
+    content.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+    content.writeDouble(v / si::meter_per_second);
+    content.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+    content.writeDouble(d / si::seconds);
+    m_traci->queueCommand(libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::CMD_SLOWDOWN, m_cache->getId(), content);
 }
 
 auto VehicleController::getLength() const -> Length
@@ -101,7 +121,7 @@ auto VehicleController::getWidth() const -> Length
 
 void VehicleController::changeTarget(const std::string& edge)
 {
-    m_traci->vehicle.changeTarget(m_cache->getId(), edge);
+    m_traci->queueString(libsumo::CMD_SET_VEHICLE_VARIABLE, libsumo::CMD_CHANGETARGET, m_cache->getId(), edge);
 }
 
 } // namespace traci
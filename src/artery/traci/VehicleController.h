@@ -8,6 +8,7 @@
 #include <vanetza/units/acceleration.hpp>
 #include <vanetza/units/angle.hpp>
 #include <vanetza/units/length.hpp>
+#include <vanetza/units/time.hpp>
 #include <vanetza/units/velocity.hpp>
 #include <string>
 
@@ -16,10 +17,17 @@ namespace traci
 
 class VehicleCache;
 
+/**
+ * VehicleController provides access to a SUMO vehicle
+ *
+ * Getters are served by a variable cache. Setters queue their TraCI commands,
+ * which are sent as one batch right before the next simulation step.
+ */
 class VehicleController
 {
 public:
     using Acceleration = vanetza::units::Acceleration;
+    using Duration = vanetza::units::Duration;
     using Length = vanetza::units::Length;
     using Velocity = vanetza::units::Velocity;
 
@@ -39,6 +47,8 @@ public:
     void setMaxSpeed(Velocity);
     void setSpeed(Velocity);
     void setSpeedFactor(double);
+    void setSpeedMode(int);
+    void slowDown(Velocity, Duration);
 
     Length getLength() const;
     Length getWidth() const;
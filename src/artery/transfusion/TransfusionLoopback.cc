@@ -1,7 +1,11 @@
 #include "TransfusionLoopback.h"
+#include "TransfusionMsg.pb.h"
 #include <boost/asio.hpp>
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
 #include <omnetpp/cmessage.h>
 #include <array>
+#include <string>
 
 using namespace omnetpp;
 
@@ -21,6 +25,7 @@ public:
         mAcceptor.listen();
         mAcceptor.async_accept(mSocket,
                 [this](const boost::system::error_code& ec) {
+                    mConnected = !ec;
                     read();
                 });
     }
@@ -32,6 +37,14 @@ public:
         return mRxBytes;
     }
 
+    bool send(const std::string& data)
+    {
+        if (mConnected) {
+            boost::asio::write(mSocket, boost::asio::buffer(data));
+        }
+        return mConnected;
+    }
+
 private:
     void read()
     {
@@ -48,11 +61,44 @@ private:
     boost::asio::ip::tcp::socket mSocket;
     std::array<uint8_t, 1024> mBuffer;
     std::size_t mRxBytes = 0;
+    bool mConnected = false;
 };
 
+namespace
+{
+
+/**
+ * Build a burst of varint-delimited SHB messages like an external application would send
+ */
+std::string buildBurst(unsigned count, unsigned payloadLength, unsigned port)
+{
+    Transfusion::TransfusionMsg msg;
+    msg.set_destination_port(port);
+    msg.set_payload(std::string(payloadLength, '\0'));
+    msg.mutable_traffic_class()->set_dcc_profile(Transfusion::TrafficClass::DP3);
+    msg.mutable_traffic_class()->set_channel_offload(false);
+    msg.mutable_traffic_class()->set_store_carry_forward(false);
+    msg.mutable_shb();
+
+    std::string burst;
+    {
+        google::protobuf::io::StringOutputStream os(&burst);
+        google::protobuf::io::CodedOutputStream cos(&os);
+        for (unsigned i = 0; i < count; ++i) {
+            cos.WriteVarint32(msg.ByteSizeLong());
+            if (!msg.SerializeToCodedStream(&cos)) {
+                throw cRuntimeError("Encoding of Transfusion message failed");
+            }
+        }
+    }
+    return burst;
+}
+
+} // namespace
+
 TransfusionLoopback::TransfusionLoopback() :
     mTimer(new omnetpp::cMessage("loopback timer")),
-    mSumRxBytes(0)
+    mSumRxBytes(0), mSumTxMessages(0)
 {
 }
 
@@ -64,12 +110,17 @@ TransfusionLoopback::~TransfusionLoopback()
 void TransfusionLoopback::initialize()
 {
     mContext = std::make_shared<Context>(par("port"));
+    mBurstSize = par("burstSize");
+    if (mBurstSize > 0) {
+        mBurst = buildBurst(mBurstSize, par("burstPayloadLength"), par("burstDestinationPort"));
+    }
     scheduleAt(simTime(), mTimer);
 }
 
 void TransfusionLoopback::finish()
 {
     recordScalar("sumRxBytes", mSumRxBytes);
+    recordScalar("sumTxMessages", mSumTxMessages);
 }
 
 void TransfusionLoopback::handleMessage(omnetpp::cMessage* msg)
@@ -78,6 +129,9 @@ void TransfusionLoopback::handleMessage(omnetpp::cMessage* msg)
         const std::size_t bytes = mContext->receive();
         mSumRxBytes += bytes;
         EV_INFO << "received " << bytes << " bytes\n";
+        if (!mBurst.empty() && mContext->send(mBurst)) {
+            mSumTxMessages += mBurstSize;
+        }
         scheduleAt(simTime() + SimTime { 100, SIMTIME_MS }, mTimer);
     }
 }
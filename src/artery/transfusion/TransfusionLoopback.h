@@ -3,6 +3,7 @@
 
 #include <omnetpp/csimplemodule.h>
 #include <memory>
+#include <string>
 
 namespace artery
 {
@@ -22,6 +23,9 @@ private:
     std::shared_ptr<Context> mContext;
     omnetpp::cMessage* mTimer;
     unsigned mSumRxBytes;
+    unsigned mSumTxMessages;
+    unsigned mBurstSize = 0;
+    std::string mBurst;
 };
 
 } // namespace artery
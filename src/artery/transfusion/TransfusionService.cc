@@ -32,10 +32,24 @@ namespace artery
 
 Define_Module(TransfusionService)
 
+static const simsignal_t scBatchSignal = cComponent::registerSignal("TransfusionBatch");
+// a varint32 occupies at most five bytes, decoding fails afterwards only for malformed prefixes
+static const std::size_t scMaxVarint32Length = 5;
+
+TransfusionService::TransfusionService() :
+    m_message(new Transfusion::TransfusionMsg())
+{
+}
+
+TransfusionService::~TransfusionService()
+{
+}
+
 void TransfusionService::initialize()
 {
     ItsG5BaseService::initialize();
     GOOGLE_PROTOBUF_VERIFY_VERSION;
+    m_max_message_length = par("max_message_length");
 
     AsioScheduler* scheduler = check_and_cast<AsioScheduler*>(getSimulation()->getScheduler());
     m_asio_task = scheduler->createTask(*this);
@@ -62,24 +76,14 @@ void TransfusionService::handleMessage(cMessage* msg)
     if (msg == m_asio_task->getDataMessage())
     {
         // receiving a message from external software
-        auto buffer = m_asio_task->getDataMessage()->getBuffer();
+        const auto& buffer = m_asio_task->getDataMessage()->getBuffer();
         std::size_t len = m_asio_task->getDataMessage()->getLength();
-        std::copy(buffer.data(), buffer.data() + len, std::back_inserter(m_buffer));
+        m_buffer.insert(m_buffer.end(), buffer.data(), buffer.data() + len);
 
-        google::protobuf::io::ArrayInputStream aos(buffer.data(), buffer.size());
-        google::protobuf::io::CodedInputStream cis(&aos);
-        uint32_t msg_length = 0;
-        cis.ReadVarint32(&msg_length);
-        if (msg_length > 0 && m_buffer.size() >= msg_length) {
-            auto limit = cis.PushLimit(msg_length);
-            Transfusion::TransfusionMsg msg;
-            if (msg.ParseFromCodedStream(&cis)) {
-                processMessage(msg);
-            } else {
-                EV_WARN << "Decoding of Transfusion message failed, skip it";
-            }
-            cis.PopLimit(limit);
-            m_buffer.erase(m_buffer.begin(), m_buffer.begin() + cis.CurrentPosition());
+        // all complete messages are injected within this event, partial messages make no batch
+        const std::size_t batch = processBuffer();
+        if (batch > 0) {
+            emit(scBatchSignal, batch);
         }
 
         // signal scheduler that we are ready to handle further data
@@ -87,6 +91,55 @@ void TransfusionService::handleMessage(cMessage* msg)
     }
 }
 
+std::size_t TransfusionService::processBuffer()
+{
+    std::size_t decoded = 0;
+    std::size_t offset = 0;
+    while (offset < m_buffer.size()) {
+        const std::size_t available = m_buffer.size() - offset;
+        google::protobuf::io::CodedInputStream cis(m_buffer.data() + offset, available);
+        uint32_t msg_length = 0;
+        if (!cis.ReadVarint32(&msg_length)) {
+            if (available < scMaxVarint32Length) {
+                break; // length prefix is not complete yet
+            }
+            EV_ERROR << "Malformed length prefix of Transfusion message, drop " << available << " buffered bytes\n";
+            offset = m_buffer.size();
+            break;
+        } else if (msg_length > m_max_message_length) {
+            EV_ERROR << "Transfusion message of " << msg_length << " bytes exceeds limit of "
+                << m_max_message_length << " bytes, drop " << available << " buffered bytes\n";
+            offset = m_buffer.size();
+            break;
+        }
+
+        const std::size_t prefix_length = cis.CurrentPosition();
+        if (available - prefix_length < msg_length) {
+            break; // message body is not complete yet
+        }
+
+        auto limit = cis.PushLimit(msg_length);
+        m_message->Clear();
+        if (m_message->ParseFromCodedStream(&cis) && cis.ConsumedEntireMessage()) {
+            processMessage(*m_message);
+        } else {
+            EV_WARN << "Decoding of Transfusion message failed, skip it";
+        }
+        cis.PopLimit(limit);
+        offset += prefix_length + msg_length;
+        ++decoded;
+    }
+
+    // drop consumed prefix at most once per read, keeping a partial message at the front
+    if (offset == m_buffer.size()) {
+        m_buffer.clear();
+    } else if (offset > 0) {
+        m_buffer.erase(m_buffer.begin(), m_buffer.begin() + offset);
+    }
+
+    return decoded;
+}
+
 void TransfusionService::processMessage(const Transfusion::TransfusionMsg& msg)
 {
     using namespace vanetza;
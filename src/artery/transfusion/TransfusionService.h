@@ -36,6 +36,8 @@ namespace artery
 class TransfusionService : public ItsG5PromiscuousService
 {
     public:
+        TransfusionService();
+        virtual ~TransfusionService();
         void tapPacket(const vanetza::btp::DataIndication&, const vanetza::UpPacket&) override;
 
     protected:
@@ -43,10 +45,13 @@ class TransfusionService : public ItsG5PromiscuousService
         void handleMessage(omnetpp::cMessage*) override;
 
     private:
+        std::size_t processBuffer();
         void processMessage(const Transfusion::TransfusionMsg&);
         vanetza::geonet::Area buildDestinationArea(const Transfusion::GeoBroadcast&);
         std::unique_ptr<AsioTask> m_asio_task;
+        std::unique_ptr<Transfusion::TransfusionMsg> m_message; /*< reused for every decoded message */
         vanetza::ByteBuffer m_buffer;
+        std::size_t m_max_message_length; /*< longer messages are treated as corrupted stream */
 };
 
 } // namespace artery
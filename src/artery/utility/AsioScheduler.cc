@@ -51,7 +51,7 @@ std::chrono::steady_clock::duration steady_clock_duration(const SimTime t)
 }
 
 
-AsioScheduler::AsioScheduler() : m_work(m_service), m_timer(m_service), m_state(FluxState::PAUSED)
+AsioScheduler::AsioScheduler() : m_work(m_service), m_timer(m_service), m_state(FluxState::PAUSED), m_catch_up(0)
 {
 }
 
@@ -67,6 +67,7 @@ cEvent* AsioScheduler::guessNextEvent()
 
 cEvent* AsioScheduler::takeNextEvent()
 {
+	m_statistics.enterScheduler(std::chrono::steady_clock::now());
 	while (true) {
 		cEvent* event = sim->getFES()->peekFirst();
 		if (event) {
@@ -75,21 +76,35 @@ cEvent* AsioScheduler::takeNextEvent()
 				ASSERT(tmp == event);
 				delete tmp;
 			} else {
-				m_run_until = m_reference + steady_clock_duration(event->getArrivalTime());
+				m_run_until = deadline(event);
+				const auto now = std::chrono::steady_clock::now();
+				if (m_state == FluxState::SYNC && m_run_until <= now && m_catch_up < m_options.catchUpLimit) {
+					// overdue events are dispatched without re-entering the I/O loop
+					++m_catch_up;
+					m_statistics.countCatchUp();
+					return dispatchFirst();
+				}
+				m_catch_up = 0;
+
 				try {
 					ASSERT(!m_service.stopped());
-					setTimer();
-					while (m_state == FluxState::DWADLING) {
-						m_service.run_one();
+					// without busy polling, overdue events are synchronised by setTimer() right away
+					if (m_options.busyPoll > std::chrono::nanoseconds::zero() && m_run_until - now <= m_options.busyPoll) {
+						busyWait(event);
+					} else {
+						setTimer();
+						while (m_state == FluxState::DWADLING) {
+							m_service.run_one();
+						}
+						m_timer.cancel();
 					}
-					m_timer.cancel();
 					m_service.poll();
 				} catch (boost::system::system_error& e) {
 					cRuntimeError("AsioScheduler IO error: %s", e.what());
 				}
 
 				if (m_state == FluxState::SYNC) {
-					return sim->getFES()->removeFirst();
+					return dispatchFirst();
 				} else {
 					return nullptr;
 				}
@@ -100,6 +115,37 @@ cEvent* AsioScheduler::takeNextEvent()
 	}
 }
 
+cEvent* AsioScheduler::dispatchFirst()
+{
+	cEvent* event = sim->getFES()->removeFirst();
+	const auto now = std::chrono::steady_clock::now();
+	m_statistics.leaveScheduler(now, now - deadline(event));
+	return event;
+}
+
+void AsioScheduler::busyWait(cEvent* event)
+{
+	// spin until deadline is reached or an I/O handler has inserted an earlier event
+	while (std::chrono::steady_clock::now() < m_run_until && sim->getFES()->peekFirst() == event) {
+		m_service.poll();
+	}
+	// user interface might have paused the simulation meanwhile, see handleTimer
+	m_state = getEnvir()->idle() ? FluxState::PAUSED : FluxState::SYNC;
+}
+
+std::chrono::steady_clock::time_point AsioScheduler::deadline(const cEvent* event) const
+{
+	return m_reference + steady_clock_duration(event->getArrivalTime());
+}
+
+void AsioScheduler::lifecycleEvent(SimulationLifecycleEventType type, cObject* details)
+{
+	if (type == LF_PRE_NETWORK_FINISH) {
+		m_statistics.record(sim->getSystemModule(), "asioScheduler");
+	}
+	cScheduler::lifecycleEvent(type, details);
+}
+
 void AsioScheduler::putBackEvent(cEvent* event)
 {
 	sim->getFES()->putBackFirst(event);
@@ -112,6 +158,9 @@ void AsioScheduler::startRun()
 		m_service.reset();
 	}
 	m_reference = std::chrono::steady_clock::now();
+	m_options = RealtimeOptions::fromConfiguration(getEnvir()->getConfig());
+	m_statistics.reset();
+	m_catch_up = 0;
 }
 
 void AsioScheduler::endRun()
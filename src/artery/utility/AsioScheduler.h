@@ -16,6 +16,7 @@
 #ifndef ARTERY_ASIOSCHEDULER_H_
 #define ARTERY_ASIOSCHEDULER_H_
 
+#include "artery/utility/RealtimeStatistics.h"
 #include <omnetpp/cmodule.h>
 #include <omnetpp/cscheduler.h>
 #include <boost/asio/io_service.hpp>
@@ -36,6 +37,8 @@ class AsioScheduler : public omnetpp::cScheduler
 		std::unique_ptr<AsioTask> createTask(omnetpp::cModule&);
 		void cancelTask(AsioTask*);
 		void processTask(AsioTask*);
+		void lifecycleEvent(omnetpp::SimulationLifecycleEventType, omnetpp::cObject*) override;
+		const RealtimeStatistics& getStatistics() const { return m_statistics; }
 
 	protected:
 		virtual omnetpp::cEvent* guessNextEvent() override;
@@ -50,6 +53,9 @@ class AsioScheduler : public omnetpp::cScheduler
 		void handleTask(AsioTask*, const boost::system::error_code&, std::size_t bytes);
 		void handleTimer(const boost::system::error_code&);
 		void setTimer();
+		void busyWait(omnetpp::cEvent*);
+		omnetpp::cEvent* dispatchFirst();
+		std::chrono::steady_clock::time_point deadline(const omnetpp::cEvent*) const;
 
 		enum class FluxState {
 			PAUSED, DWADLING, SYNC
@@ -61,6 +67,9 @@ class AsioScheduler : public omnetpp::cScheduler
 		std::chrono::steady_clock::time_point m_reference;
 		std::chrono::steady_clock::time_point m_run_until;
 		FluxState m_state;
+		RealtimeOptions m_options;
+		RealtimeStatistics m_statistics;
+		unsigned m_catch_up;
 };
 
 } // namespace artery
@@ -0,0 +1,210 @@
+#include "artery/utility/ColumnarFormat.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace artery
+{
+namespace columnar
+{
+
+namespace
+{
+
+std::uint64_t zigzag(std::int64_t value)
+{
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t unzigzag(std::uint64_t value)
+{
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+std::uint64_t bits(double value)
+{
+    std::uint64_t result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+double fromBits(std::uint64_t value)
+{
+    double result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+void writeDeltas(std::string& out, const std::vector<std::int64_t>& column)
+{
+    std::int64_t previous = 0;
+    for (std::int64_t value : column) {
+        writeVarint(out, zigzag(value - previous));
+        previous = value;
+    }
+}
+
+} // namespace
+
+void Chunk::clear()
+{
+    events.clear();
+    times.clear();
+    values.clear();
+}
+
+void writeVarint(std::string& out, std::uint64_t value)
+{
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+void writeString(std::string& out, const std::string& str)
+{
+    writeVarint(out, str.size());
+    out.append(str);
+}
+
+void writeModule(std::string& out, std::uint64_t id, const std::string& path)
+{
+    out.push_back(static_cast<char>(Tag::Module));
+    writeVarint(out, id);
+    writeString(out, path);
+}
+
+void writeVector(std::string& out, std::uint64_t id, std::uint64_t module, const std::string& name)
+{
+    out.push_back(static_cast<char>(Tag::Vector));
+    writeVarint(out, id);
+    writeVarint(out, module);
+    writeString(out, name);
+}
+
+void writeChunk(std::string& out, const Chunk& chunk)
+{
+    out.push_back(static_cast<char>(Tag::Chunk));
+    writeVarint(out, chunk.vector);
+    writeVarint(out, chunk.size());
+    writeDeltas(out, chunk.events);
+    writeDeltas(out, chunk.times);
+
+    std::uint64_t previous = 0;
+    for (double value : chunk.values) {
+        const std::uint64_t current = bits(value);
+        // values with few significant mantissa bits leave trailing zero bytes after XOR,
+        // byte reversal turns those into leading zeros and thus into short varints
+        writeVarint(out, __builtin_bswap64(current ^ previous));
+        previous = current;
+    }
+}
+
+
+Reader::Reader(std::istream& stream) : mStream(stream)
+{
+    char magic[sizeof(Magic)];
+    char exponent = 0;
+    if (!mStream.read(magic, sizeof(magic)) || std::memcmp(magic, Magic, sizeof(Magic)) != 0) {
+        throw std::runtime_error("not a columnar result file");
+    } else if (!mStream.get(exponent)) {
+        throw std::runtime_error("truncated columnar result file header");
+    }
+    mScaleExponent = static_cast<signed char>(exponent);
+
+    const std::istream::pos_type records = mStream.tellg();
+    if (records == std::istream::pos_type(-1) || !mStream.seekg(0, std::ios::end)) {
+        throw std::runtime_error("columnar result file is not seekable");
+    }
+    mEnd = mStream.tellg();
+    mStream.seekg(records);
+}
+
+bool Reader::next(Tag& tag)
+{
+    char c = 0;
+    if (!mStream.get(c)) {
+        return false;
+    }
+
+    tag = static_cast<Tag>(c);
+    switch (tag) {
+        case Tag::Module:
+            mModule.id = readVarint();
+            mModule.path = readString();
+            break;
+        case Tag::Vector:
+            mVector.id = readVarint();
+            mVector.module = readVarint();
+            mVector.name = readString();
+            break;
+        case Tag::Chunk: {
+            mChunk.clear();
+            mChunk.vector = readVarint();
+            const std::uint64_t count = readVarint();
+            // each sample takes at least one byte per column
+            if (count > remaining() / 3) {
+                throw std::runtime_error("chunk exceeds columnar result file");
+            }
+            std::int64_t previous = 0;
+            for (std::uint64_t i = 0; i < count; ++i) {
+                previous += unzigzag(readVarint());
+                mChunk.events.push_back(previous);
+            }
+            previous = 0;
+            for (std::uint64_t i = 0; i < count; ++i) {
+                previous += unzigzag(readVarint());
+                mChunk.times.push_back(previous);
+            }
+            std::uint64_t pattern = 0;
+            for (std::uint64_t i = 0; i < count; ++i) {
+                pattern ^= __builtin_bswap64(readVarint());
+                mChunk.values.push_back(fromBits(pattern));
+            }
+            break;
+        }
+        default:
+            throw std::runtime_error("unknown record in columnar result file");
+    }
+
+    return true;
+}
+
+std::uint64_t Reader::readVarint()
+{
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        char c = 0;
+        if (!mStream.get(c)) {
+            throw std::runtime_error("truncated columnar result file");
+        }
+        value |= static_cast<std::uint64_t>(c & 0x7f) << shift;
+        if ((c & 0x80) == 0) {
+            return value;
+        }
+    }
+    throw std::runtime_error("malformed varint in columnar result file");
+}
+
+std::string Reader::readString()
+{
+    const std::uint64_t length = readVarint();
+    if (length > remaining()) {
+        throw std::runtime_error("string exceeds columnar result file");
+    }
+
+    std::string str(length, '\0');
+    if (!mStream.read(&str[0], str.size())) {
+        throw std::runtime_error("truncated string in columnar result file");
+    }
+    return str;
+}
+
+std::uint64_t Reader::remaining()
+{
+    const std::istream::pos_type position = mStream.tellg();
+    return position == std::istream::pos_type(-1) || position > mEnd ? 0 : static_cast<std::uint64_t>(mEnd - position);
+}
+
+} // namespace columnar
+} // namespace artery
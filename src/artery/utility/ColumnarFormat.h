@@ -0,0 +1,111 @@
+#ifndef ARTERY_COLUMNARFORMAT_H_T7QXW2LD
+#define ARTERY_COLUMNARFORMAT_H_T7QXW2LD
+
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace artery
+{
+namespace columnar
+{
+
+/**
+ * Binary columnar result file layout
+ *
+ * A file starts with an 8 byte magic followed by the simulation time scale
+ * exponent (signed byte). Records follow, each introduced by a tag byte:
+ *  - Module:  varint id, string full path of module
+ *  - Vector:  varint id, varint module id, string result name
+ *  - Chunk:   varint vector id, varint sample count, column of event numbers,
+ *             column of times and column of values
+ *
+ * Strings are stored as varint length plus raw bytes. Event numbers and times
+ * are delta encoded as zig-zag varints, values are XORed with their
+ * predecessor and stored byte-reversed as varints, i.e. repeated or slowly
+ * changing values shrink to a few bytes. Deltas and XORs restart in each chunk.
+ */
+static const char Magic[8] = { 'A', 'R', 'T', 'C', 'O', 'L', '1', '\0' };
+
+enum class Tag : std::uint8_t
+{
+    Module = 'M',
+    Vector = 'V',
+    Chunk = 'C'
+};
+
+struct Chunk
+{
+    std::uint64_t vector = 0;
+    std::vector<std::int64_t> events;
+    std::vector<std::int64_t> times; /*< raw simulation time values */
+    std::vector<double> values;
+
+    std::size_t size() const { return values.size(); }
+    void clear();
+};
+
+void writeVarint(std::string& out, std::uint64_t);
+void writeString(std::string& out, const std::string&);
+void writeModule(std::string& out, std::uint64_t id, const std::string& path);
+void writeVector(std::string& out, std::uint64_t id, std::uint64_t module, const std::string& name);
+void writeChunk(std::string& out, const Chunk&);
+
+/**
+ * Sequential reader of columnar result files
+ */
+class Reader
+{
+public:
+    struct Module
+    {
+        std::uint64_t id;
+        std::string path;
+    };
+
+    struct Vector
+    {
+        std::uint64_t id;
+        std::uint64_t module;
+        std::string name;
+    };
+
+    /**
+     * Read file header
+     *
+     * Lengths read from the stream are checked against its size, thus the stream has to be seekable.
+     * \throw std::runtime_error if stream is no (seekable) columnar result file
+     */
+    explicit Reader(std::istream&);
+
+    int getScaleExponent() const { return mScaleExponent; }
+
+    /**
+     * Read next record
+     * \return tag of read record, false at end of stream
+     * \throw std::runtime_error on malformed records
+     */
+    bool next(Tag&);
+
+    const Module& module() const { return mModule; }
+    const Vector& vector() const { return mVector; }
+    const Chunk& chunk() const { return mChunk; }
+
+private:
+    std::uint64_t readVarint();
+    std::string readString();
+    std::uint64_t remaining();
+
+    std::istream& mStream;
+    std::istream::pos_type mEnd;
+    int mScaleExponent;
+    Module mModule;
+    Vector mVector;
+    Chunk mChunk;
+};
+
+} // namespace columnar
+} // namespace artery
+
+#endif /* ARTERY_COLUMNARFORMAT_H_T7QXW2LD */
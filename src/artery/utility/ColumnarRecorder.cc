@@ -0,0 +1,212 @@
+#include "artery/utility/ColumnarRecorder.h"
+#include <omnetpp/ccomponent.h>
+#include <omnetpp/cconfigoption.h>
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/cenvir.h>
+#include <omnetpp/cexception.h>
+#include <omnetpp/csimulation.h>
+#include <omnetpp/regmacros.h>
+#include <omnetpp/simtime.h>
+#include <sys/stat.h>
+#include <algorithm>
+#include <cerrno>
+#include <utility>
+
+namespace artery
+{
+
+Register_PerRunConfigOption(CFGID_COLUMNAR_FILE, "columnar-file", CFG_FILENAME,
+        "${resultdir}/${configname}-${iterationvarsf}#${repetition}.vcol",
+        "Output file of the columnar result recorder, see columnar2csv for conversion.")
+Register_GlobalConfigOption(CFGID_COLUMNAR_CHUNK_SIZE, "columnar-chunk-size", CFG_INT, "4096",
+        "Number of samples a columnar result recorder buffers before handing them over to the background writer.")
+
+Register_ResultRecorder("columnar", ColumnarRecorder)
+
+namespace
+{
+
+void makeParentDirectories(const std::string& path)
+{
+    for (std::size_t slash = path.find('/', 1); slash != std::string::npos; slash = path.find('/', slash + 1)) {
+        const std::string directory = path.substr(0, slash);
+        if (::mkdir(directory.c_str(), 0777) != 0 && errno != EEXIST) {
+            throw omnetpp::cRuntimeError("Cannot create directory %s for columnar results", directory.c_str());
+        }
+    }
+}
+
+} // namespace
+
+ColumnarWriter& ColumnarWriter::instance()
+{
+    static ColumnarWriter writer;
+    return writer;
+}
+
+ColumnarWriter::ColumnarWriter() :
+    mChunkSize(0), mNextVector(0), mStopping(false), mOpen(false), mFailed(false)
+{
+}
+
+ColumnarWriter::~ColumnarWriter()
+{
+    close();
+}
+
+std::uint64_t ColumnarWriter::registerVector(const omnetpp::cComponent* component, const std::string& name)
+{
+    // writer thread uses mFile, thus the simulation thread does not inspect it
+    if (!mOpen) {
+        open();
+    }
+
+    Job job;
+    auto inserted = mModules.emplace(component->getId(), mModules.size());
+    const std::uint64_t module = inserted.first->second;
+    if (inserted.second) {
+        columnar::writeModule(job.record, module, component->getFullPath());
+    }
+
+    const std::uint64_t vector = mNextVector++;
+    columnar::writeVector(job.record, vector, module, name);
+    enqueue(std::move(job));
+    return vector;
+}
+
+void ColumnarWriter::submit(columnar::Chunk& chunk)
+{
+    if (!mOpen) {
+        throw omnetpp::cRuntimeError("Columnar result file is not open");
+    }
+
+    Job job;
+    std::swap(job.chunk, chunk);
+    chunk.vector = job.chunk.vector;
+    chunk.events.reserve(mChunkSize);
+    chunk.times.reserve(mChunkSize);
+    chunk.values.reserve(mChunkSize);
+    enqueue(std::move(job));
+}
+
+void ColumnarWriter::enqueue(Job&& job)
+{
+    if (mFailed) {
+        throw omnetpp::cRuntimeError("Writing columnar results to %s failed", mFileName.c_str());
+    }
+    std::lock_guard<std::mutex> lock(mMutex);
+    mQueue.push_back(std::move(job));
+    mWakeUp.notify_one();
+}
+
+void ColumnarWriter::open()
+{
+    omnetpp::cEnvir* envir = omnetpp::getEnvir();
+    omnetpp::cConfiguration* config = envir->getConfig();
+    mFileName = config->getAsFilename(CFGID_COLUMNAR_FILE);
+    mChunkSize = std::max<long>(1, config->getAsInt(CFGID_COLUMNAR_CHUNK_SIZE));
+
+    makeParentDirectories(mFileName);
+    mFile.open(mFileName, std::ios::binary | std::ios::trunc);
+    if (!mFile) {
+        throw omnetpp::cRuntimeError("Cannot open columnar result file %s", mFileName.c_str());
+    }
+    mFile.write(columnar::Magic, sizeof(columnar::Magic));
+    mFile.put(static_cast<char>(omnetpp::SimTime::getScaleExp()));
+
+    mModules.clear();
+    mNextVector = 0;
+    mStopping = false;
+    mFailed = false;
+    mOpen = true;
+    mThread = std::thread(&ColumnarWriter::run, this);
+    envir->addLifecycleListener(this);
+}
+
+void ColumnarWriter::close()
+{
+    if (mThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(mMutex);
+            mStopping = true;
+        }
+        mWakeUp.notify_one();
+        mThread.join();
+    }
+
+    // writer thread has finished, i.e. mFile is accessed by this thread only
+    if (mFile.is_open()) {
+        mFile.close();
+    }
+    mOpen = false;
+}
+
+void ColumnarWriter::lifecycleEvent(omnetpp::SimulationLifecycleEventType event, omnetpp::cObject*)
+{
+    // recorders flush their pending chunks in finish(), i.e. before the network is deleted
+    if (event == omnetpp::LF_PRE_NETWORK_DELETE || event == omnetpp::LF_ON_RUN_END) {
+        close();
+        omnetpp::getEnvir()->removeLifecycleListener(this);
+    }
+}
+
+void ColumnarWriter::run()
+{
+    std::deque<Job> jobs;
+    std::string buffer;
+    bool stopping = false;
+
+    while (!stopping) {
+        {
+            std::unique_lock<std::mutex> lock(mMutex);
+            mWakeUp.wait(lock, [this]() { return mStopping || !mQueue.empty(); });
+            std::swap(jobs, mQueue);
+            stopping = mStopping;
+        }
+
+        // encode everything queued so far into one write
+        buffer.clear();
+        for (const Job& job : jobs) {
+            if (job.record.empty()) {
+                columnar::writeChunk(buffer, job.chunk);
+            } else {
+                buffer.append(job.record);
+            }
+        }
+        jobs.clear();
+
+        if (!buffer.empty() && !mFile.write(buffer.data(), buffer.size())) {
+            mFailed = true;
+            return;
+        }
+    }
+
+    if (!mFile.flush()) {
+        mFailed = true;
+    }
+}
+
+void ColumnarRecorder::collect(omnetpp::simtime_t_cref t, double value, omnetpp::cObject*)
+{
+    ColumnarWriter& writer = ColumnarWriter::instance();
+    if (!mRegistered) {
+        mChunk.vector = writer.registerVector(getComponent(), getResultName());
+        mRegistered = true;
+    }
+
+    mChunk.events.push_back(omnetpp::getSimulation()->getEventNumber());
+    mChunk.times.push_back(t.raw());
+    mChunk.values.push_back(value);
+    if (mChunk.size() >= writer.getChunkSize()) {
+        writer.submit(mChunk);
+    }
+}
+
+void ColumnarRecorder::finish(omnetpp::cResultFilter*)
+{
+    if (mChunk.size() > 0) {
+        ColumnarWriter::instance().submit(mChunk);
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,99 @@
+#ifndef ARTERY_COLUMNARRECORDER_H_B5MJ0RZK
+#define ARTERY_COLUMNARRECORDER_H_B5MJ0RZK
+
+#include "artery/utility/ColumnarFormat.h"
+#include <omnetpp/clifecyclelistener.h>
+#include <omnetpp/cresultrecorder.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace artery
+{
+
+/**
+ * ColumnarWriter collects chunks of all columnar recorders of a run in one file
+ *
+ * Encoding and file output take place on a background thread, i.e. the
+ * simulation thread only hands over filled chunks. The file is opened when
+ * the first vector is registered and closed at the end of each run.
+ */
+class ColumnarWriter : public omnetpp::cISimulationLifecycleListener
+{
+public:
+    static ColumnarWriter& instance();
+
+    /**
+     * Register a result vector
+     * \param component emitting component, its path is dictionary encoded
+     * \param name result name
+     * \return vector id for submitted chunks
+     */
+    std::uint64_t registerVector(const omnetpp::cComponent* component, const std::string& name);
+
+    /**
+     * Hand over a chunk to the background writer
+     * \param chunk is left empty
+     */
+    void submit(columnar::Chunk& chunk);
+
+    std::size_t getChunkSize() const { return mChunkSize; }
+
+    void lifecycleEvent(omnetpp::SimulationLifecycleEventType, omnetpp::cObject*) override;
+
+private:
+    struct Job
+    {
+        std::string record; /*< encoded meta data record */
+        columnar::Chunk chunk; /*< chunk to be encoded if record is empty */
+    };
+
+    ColumnarWriter();
+    ~ColumnarWriter();
+    void open();
+    void close();
+    void enqueue(Job&&);
+    void run();
+
+    std::size_t mChunkSize;
+    std::ofstream mFile;
+    std::string mFileName;
+    std::unordered_map<int, std::uint64_t> mModules;
+    std::uint64_t mNextVector;
+
+    std::thread mThread;
+    std::mutex mMutex;
+    std::condition_variable mWakeUp;
+    std::deque<Job> mQueue;
+    bool mStopping;
+    std::atomic<bool> mOpen; /*< file is open and writer thread is running */
+    std::atomic<bool> mFailed; /*< set by writer thread if writing failed */
+};
+
+/**
+ * Result recorder storing vectors in Artery's binary columnar format
+ *
+ * Select it per statistic by "record=columnar" in NED @statistic properties
+ * or by result-recording-modes in omnetpp.ini.
+ * Files are converted to CSV by the columnar2csv tool.
+ */
+class ColumnarRecorder : public omnetpp::cNumericResultRecorder
+{
+protected:
+    void collect(omnetpp::simtime_t_cref, double, omnetpp::cObject*) override;
+    void finish(omnetpp::cResultFilter*) override;
+
+private:
+    columnar::Chunk mChunk;
+    bool mRegistered = false;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_COLUMNARRECORDER_H_B5MJ0RZK */
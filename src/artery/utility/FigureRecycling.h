@@ -0,0 +1,82 @@
+#ifndef ARTERY_FIGURERECYCLING_H_QN4WZ7XD
+#define ARTERY_FIGURERECYCLING_H_QN4WZ7XD
+
+#include "artery/utility/Geometry.h"
+#include <omnetpp/ccanvas.h>
+
+namespace artery
+{
+namespace figures
+{
+
+/**
+ * Get figure at given index of a group figure
+ *
+ * A new figure is appended if the group has no figure at this index yet.
+ * Previously hidden figures become visible again. This allows to recycle figures
+ * across display refreshes instead of deleting and allocating them every time.
+ *
+ * \param group figure containing only figures of type F
+ * \param index child index
+ * \return figure of type F
+ */
+template<typename F>
+F* recycle(omnetpp::cGroupFigure* group, int index)
+{
+    F* figure = nullptr;
+    if (index < group->getNumFigures()) {
+        figure = static_cast<F*>(group->getFigure(index));
+        if (!figure->isVisible()) {
+            figure->setVisible(true);
+        }
+    } else {
+        figure = new F();
+        group->addFigure(figure);
+    }
+    return figure;
+}
+
+/**
+ * Hide all figures of a group starting at given index
+ *
+ * Use this after recycling figures to hide the unused remainder.
+ */
+inline void hideRemaining(omnetpp::cGroupFigure* group, int index)
+{
+    for (int i = index; i < group->getNumFigures(); ++i) {
+        omnetpp::cFigure* figure = group->getFigure(i);
+        if (figure->isVisible()) {
+            figure->setVisible(false);
+        }
+    }
+}
+
+/**
+ * Update points of a polygon or polyline figure in place
+ *
+ * \param figure cPolygonFigure or cPolylineFigure
+ * \param positions range of artery::Position
+ */
+template<typename F, typename R>
+void assignPoints(F* figure, const R& positions)
+{
+    int index = 0;
+    for (const Position& pos : positions) {
+        const omnetpp::cFigure::Point point { pos.x.value(), pos.y.value() };
+        if (index < figure->getNumPoints()) {
+            figure->setPoint(index, point);
+        } else {
+            figure->addPoint(point);
+        }
+        ++index;
+    }
+
+    while (figure->getNumPoints() > index) {
+        figure->removePoint(figure->getNumPoints() - 1);
+    }
+}
+
+} // namespace figures
+} // namespace artery
+
+#endif /* ARTERY_FIGURERECYCLING_H_QN4WZ7XD */
@@ -11,8 +11,8 @@
 #include <omnetpp/clistener.h>
 #include <omnetpp/csimplemodule.h>
 #include <boost/multi_index_container.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/member.hpp>
-#include <boost/multi_index/ordered_index.hpp>
 #include <boost/optional/optional.hpp>
 
 namespace artery
@@ -32,24 +32,35 @@ public:
     boost::optional<Identity> lookup(const VALUE& value)
     {
         boost::optional<Identity> result;
-        auto& index = mIdentities.get<TAG>();
-        auto found = index.find(value);
-        if (found != index.end()) {
-            result = *found;
+        const Identity* identity = find<TAG>(value);
+        if (identity) {
+            result = *identity;
         }
         return result;
     }
 
+    /**
+     * Find identity without copying it
+     * \return registered identity or nullptr, pointer is valid until identity is updated or removed
+     */
+    template<typename TAG, typename VALUE>
+    const Identity* find(const VALUE& value) const
+    {
+        auto& index = mIdentities.get<TAG>();
+        auto found = index.find(value);
+        return found != index.end() ? &*found : nullptr;
+    }
+
     struct traci {};
     struct application {};
 
 private:
     boost::multi_index_container<Identity,
         boost::multi_index::indexed_by<
-            boost::multi_index::ordered_unique<
+            boost::multi_index::hashed_unique<
                 boost::multi_index::tag<traci>,
                 boost::multi_index::member<Identity, std::string, &Identity::traci>>,
-            boost::multi_index::ordered_non_unique<
+            boost::multi_index::hashed_non_unique<
                 boost::multi_index::tag<application>,
                 boost::multi_index::member<Identity, uint32_t, &Identity::application>>
         >> mIdentities;
@@ -0,0 +1,420 @@
+#include "artery/utility/ObstacleSnapshot.h"
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace artery
+{
+
+// definitions required by C++14 as these constants are bound to references
+constexpr std::uint32_t ObstacleSnapshot::Version;
+constexpr std::uint32_t ObstacleSnapshot::NodeCapacity;
+
+namespace
+{
+
+const char Magic[8] = { 'A', 'R', 'T', 'O', 'B', 'S', 'T', '\0' };
+const std::uint32_t ByteOrderMark = 0x01020304;
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint64_t key;
+    std::uint64_t obstacles;
+    std::uint64_t points;
+    std::uint64_t nodes;
+    std::uint64_t type_bytes;
+    std::uint64_t id_bytes;
+};
+
+static_assert(sizeof(Header) == 64, "unexpected padding of snapshot header");
+static_assert(sizeof(ObstacleSnapshot::Obstacle) == 64, "unexpected padding of snapshot obstacle");
+static_assert(sizeof(ObstacleSnapshot::Node) == 48, "unexpected padding of snapshot node");
+static_assert(std::is_trivially_copyable<ObstacleSnapshot::Obstacle>::value, "obstacle has to be trivially copyable");
+static_assert(std::is_trivially_copyable<ObstacleSnapshot::Node>::value, "node has to be trivially copyable");
+
+std::size_t aligned(std::size_t bytes)
+{
+    return (bytes + 7) & ~static_cast<std::size_t>(7);
+}
+
+using Box = ObstacleSnapshot::Box;
+using Point = ObstacleSnapshot::Point;
+
+Box envelope(const std::vector<Point>& outline)
+{
+    Box box { std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity(),
+        -std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity() };
+    for (const Point& point : outline) {
+        box.min_x = std::min(box.min_x, point.x);
+        box.min_y = std::min(box.min_y, point.y);
+        box.max_x = std::max(box.max_x, point.x);
+        box.max_y = std::max(box.max_y, point.y);
+    }
+    return box;
+}
+
+void expand(Box& box, const Box& other)
+{
+    box.min_x = std::min(box.min_x, other.min_x);
+    box.min_y = std::min(box.min_y, other.min_y);
+    box.max_x = std::max(box.max_x, other.max_x);
+    box.max_y = std::max(box.max_y, other.max_y);
+}
+
+/**
+ * Order boxes by Sort-Tile-Recursive for packing them into nodes of given capacity
+ * \return permutation of box indices, consecutive groups of capacity belong to one node
+ */
+std::vector<std::size_t> tile(const std::vector<Box>& boxes, std::size_t capacity)
+{
+    std::vector<std::size_t> order(boxes.size());
+    std::iota(order.begin(), order.end(), 0);
+    auto center_x = [&boxes](std::size_t i) { return boxes[i].min_x + boxes[i].max_x; };
+    auto center_y = [&boxes](std::size_t i) { return boxes[i].min_y + boxes[i].max_y; };
+
+    const std::size_t leaves = (boxes.size() + capacity - 1) / capacity;
+    const std::size_t slices = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(leaves))));
+    const std::size_t slice_size = slices * capacity;
+    std::sort(order.begin(), order.end(),
+            [&](std::size_t a, std::size_t b) { return center_x(a) < center_x(b); });
+    for (std::size_t first = 0; first < order.size(); first += slice_size) {
+        auto last = order.begin() + std::min(first + slice_size, order.size());
+        std::sort(order.begin() + first, last,
+                [&](std::size_t a, std::size_t b) { return center_y(a) < center_y(b); });
+    }
+    return order;
+}
+
+} // namespace
+
+void ObstacleSnapshot::Builder::add(const std::string& id, const std::string& type, std::vector<Point> outline,
+        std::uint32_t flags)
+{
+    if (outline.empty()) {
+        throw std::invalid_argument("obstacle " + id + " has no outline");
+    }
+
+    auto found = std::find(mTypes.begin(), mTypes.end(), type);
+    const auto type_index = static_cast<std::uint32_t>(found - mTypes.begin());
+    if (found == mTypes.end()) {
+        mTypes.push_back(type);
+    }
+    mEntries.push_back(Entry { id, type_index, flags, std::move(outline) });
+}
+
+std::shared_ptr<const ObstacleSnapshot> ObstacleSnapshot::Builder::build(std::uint64_t key) const
+{
+    if (mEntries.size() > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::length_error("too many obstacles for snapshot");
+    }
+
+    // leaf level determines obstacle order
+    std::vector<Box> boxes;
+    boxes.reserve(mEntries.size());
+    for (const Entry& entry : mEntries) {
+        boxes.push_back(envelope(entry.outline));
+    }
+    const std::vector<std::size_t> order = tile(boxes, NodeCapacity);
+
+    std::vector<Node> nodes;
+    std::size_t level_begin = 0;
+    for (std::size_t first = 0; first < order.size(); first += NodeCapacity) {
+        Node leaf {};
+        leaf.first = static_cast<std::uint32_t>(first);
+        leaf.count = static_cast<std::uint32_t>(std::min<std::size_t>(NodeCapacity, order.size() - first));
+        leaf.leaf = 1;
+        leaf.box = boxes[order[first]];
+        for (std::size_t i = first; i < first + leaf.count; ++i) {
+            expand(leaf.box, boxes[order[i]]);
+        }
+        nodes.push_back(leaf);
+    }
+
+    // pack each level into parent nodes until a single root remains
+    while (nodes.size() - level_begin > 1) {
+        std::vector<Box> level_boxes;
+        for (std::size_t i = level_begin; i < nodes.size(); ++i) {
+            level_boxes.push_back(nodes[i].box);
+        }
+        const std::vector<std::size_t> level_order = tile(level_boxes, NodeCapacity);
+        std::vector<Node> level(level_order.size());
+        for (std::size_t i = 0; i < level_order.size(); ++i) {
+            level[i] = nodes[level_begin + level_order[i]];
+        }
+        std::copy(level.begin(), level.end(), nodes.begin() + level_begin);
+
+        const std::size_t level_end = nodes.size();
+        for (std::size_t first = level_begin; first < level_end; first += NodeCapacity) {
+            Node parent {};
+            parent.first = static_cast<std::uint32_t>(first);
+            parent.count = static_cast<std::uint32_t>(std::min<std::size_t>(NodeCapacity, level_end - first));
+            parent.leaf = 0;
+            parent.box = nodes[first].box;
+            for (std::size_t i = first; i < first + parent.count; ++i) {
+                expand(parent.box, nodes[i].box);
+            }
+            nodes.push_back(parent);
+        }
+        level_begin = level_end;
+    }
+
+    std::size_t point_count = 0;
+    std::size_t id_bytes = 0;
+    for (const Entry& entry : mEntries) {
+        point_count += entry.outline.size();
+        id_bytes += entry.id.size();
+    }
+    std::size_t type_bytes = 0;
+    for (const std::string& type : mTypes) {
+        type_bytes += type.size() + 1;
+    }
+
+    Header header {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = Version;
+    header.byte_order = ByteOrderMark;
+    header.key = key;
+    header.obstacles = mEntries.size();
+    header.points = point_count;
+    header.nodes = nodes.size();
+    header.type_bytes = type_bytes;
+    header.id_bytes = id_bytes;
+
+    const std::size_t obstacles_offset = sizeof(Header);
+    const std::size_t points_offset = obstacles_offset + mEntries.size() * sizeof(Obstacle);
+    const std::size_t nodes_offset = points_offset + point_count * sizeof(Point);
+    const std::size_t types_offset = nodes_offset + nodes.size() * sizeof(Node);
+    const std::size_t ids_offset = types_offset + type_bytes;
+
+    std::shared_ptr<ObstacleSnapshot> snapshot { new ObstacleSnapshot() };
+    std::vector<char>& buffer = snapshot->mBuffer;
+    buffer.resize(aligned(ids_offset + id_bytes));
+    std::memcpy(&buffer[0], &header, sizeof(Header));
+
+    std::size_t point_offset = 0;
+    std::size_t id_offset = 0;
+    for (std::size_t i = 0; i < order.size(); ++i) {
+        const Entry& entry = mEntries[order[i]];
+        Obstacle obstacle {};
+        obstacle.box = boxes[order[i]];
+        obstacle.first_point = point_offset;
+        obstacle.point_count = static_cast<std::uint32_t>(entry.outline.size());
+        obstacle.type = entry.type;
+        obstacle.id_offset = id_offset;
+        obstacle.id_length = static_cast<std::uint32_t>(entry.id.size());
+        obstacle.flags = entry.flags;
+        std::memcpy(&buffer[obstacles_offset + i * sizeof(Obstacle)], &obstacle, sizeof(Obstacle));
+        if (!entry.outline.empty()) {
+            std::memcpy(&buffer[points_offset + point_offset * sizeof(Point)], entry.outline.data(),
+                    entry.outline.size() * sizeof(Point));
+        }
+        std::memcpy(&buffer[ids_offset + id_offset], entry.id.data(), entry.id.size());
+        point_offset += entry.outline.size();
+        id_offset += entry.id.size();
+    }
+    if (!nodes.empty()) {
+        std::memcpy(&buffer[nodes_offset], nodes.data(), nodes.size() * sizeof(Node));
+    }
+    char* type_names = buffer.data() + types_offset;
+    for (const std::string& type : mTypes) {
+        type_names = std::copy(type.begin(), type.end(), type_names);
+        *type_names++ = '\0';
+    }
+
+    snapshot->attach(buffer.data(), buffer.size());
+    return snapshot;
+}
+
+std::shared_ptr<const ObstacleSnapshot> ObstacleSnapshot::map(const std::string& file, std::uint64_t key)
+{
+    auto snapshot = map(file);
+    if (snapshot && snapshot->key() != key) {
+        snapshot.reset();
+    }
+    return snapshot;
+}
+
+std::shared_ptr<const ObstacleSnapshot> ObstacleSnapshot::map(const std::string& file)
+{
+    const int fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (errno == ENOENT) {
+            return nullptr;
+        }
+        throw std::runtime_error("cannot open obstacle snapshot " + file);
+    }
+
+    struct stat status;
+    Header header;
+    if (::fstat(fd, &status) != 0 || ::pread(fd, &header, sizeof(header), 0) != sizeof(header)) {
+        ::close(fd);
+        throw std::runtime_error("cannot read header of obstacle snapshot " + file);
+    } else if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        ::close(fd);
+        throw std::runtime_error(file + " is no obstacle snapshot");
+    } else if (header.version != Version || header.byte_order != ByteOrderMark) {
+        ::close(fd);
+        return nullptr;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(status.st_size);
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("cannot map obstacle snapshot " + file);
+    }
+
+    std::shared_ptr<ObstacleSnapshot> snapshot { new ObstacleSnapshot() };
+    snapshot->mMapping = mapping;
+    snapshot->mSize = size;
+    try {
+        snapshot->attach(static_cast<const char*>(mapping), size);
+    } catch (const std::runtime_error& e) {
+        throw std::runtime_error("obstacle snapshot " + file + " is corrupt: " + e.what());
+    }
+    return snapshot;
+}
+
+void ObstacleSnapshot::write(const std::string& file) const
+{
+    // concurrent writers (e.g. parallel sweep workers) never expose partially written files
+    const std::string temporary = file + ".tmp" + std::to_string(::getpid());
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    if (!out || !out.write(mData, mSize) || (out.close(), !out)) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("cannot write obstacle snapshot " + temporary);
+    }
+    if (std::rename(temporary.c_str(), file.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error("cannot replace obstacle snapshot " + file);
+    }
+}
+
+ObstacleSnapshot::~ObstacleSnapshot()
+{
+    if (mMapping) {
+        ::munmap(mMapping, mSize);
+    }
+}
+
+void ObstacleSnapshot::attach(const char* data, std::size_t size)
+{
+    if (size < sizeof(Header)) {
+        throw std::runtime_error("truncated header");
+    }
+
+    Header header;
+    std::memcpy(&header, data, sizeof(Header));
+    if (header.obstacles > size / sizeof(Obstacle) || header.points > size / sizeof(Point) ||
+            header.nodes > size / sizeof(Node) || header.type_bytes > size || header.id_bytes > size) {
+        throw std::runtime_error("section sizes exceed file");
+    }
+
+    const std::size_t obstacles_offset = sizeof(Header);
+    const std::size_t points_offset = obstacles_offset + header.obstacles * sizeof(Obstacle);
+    const std::size_t nodes_offset = points_offset + header.points * sizeof(Point);
+    const std::size_t types_offset = nodes_offset + header.nodes * sizeof(Node);
+    const std::size_t ids_offset = types_offset + header.type_bytes;
+    if (header.obstacles > std::numeric_limits<std::uint32_t>::max() || header.nodes > header.obstacles + 1 ||
+            ids_offset + header.id_bytes > size) {
+        throw std::runtime_error("section sizes exceed file");
+    }
+
+    mData = data;
+    mSize = size;
+    mObstacles = reinterpret_cast<const Obstacle*>(data + obstacles_offset);
+    mPoints = reinterpret_cast<const Point*>(data + points_offset);
+    mNodes = reinterpret_cast<const Node*>(data + nodes_offset);
+    mIds = data + ids_offset;
+    mObstacleCount = header.obstacles;
+    mPointCount = header.points;
+    mNodeCount = header.nodes;
+    mIdBytes = header.id_bytes;
+
+    mTypes.clear();
+    for (const char* type = data + types_offset; type < mIds; type += mTypes.back().size() + 1) {
+        mTypes.emplace_back(type, ::strnlen(type, mIds - type));
+    }
+
+    for (std::size_t i = 0; i < mObstacleCount; ++i) {
+        const Obstacle& obstacle = mObstacles[i];
+        if (obstacle.first_point + obstacle.point_count > mPointCount ||
+                obstacle.id_offset + obstacle.id_length > mIdBytes || obstacle.type >= mTypes.size()) {
+            throw std::runtime_error("obstacle references exceed sections");
+        }
+    }
+    for (std::size_t i = 0; i < mNodeCount; ++i) {
+        // inner nodes must only refer to preceding nodes, thus the tree is free of cycles
+        const Node& node = mNodes[i];
+        const std::size_t limit = node.leaf ? mObstacleCount : i;
+        if (node.count > NodeCapacity || node.first + node.count > limit) {
+            throw std::runtime_error("node references exceed sections");
+        }
+    }
+}
+
+std::uint64_t ObstacleSnapshot::key() const
+{
+    Header header;
+    std::memcpy(&header, mData, sizeof(Header));
+    return header.key;
+}
+
+auto ObstacleSnapshot::outline(std::size_t i) const -> Outline
+{
+    const Point* first = mPoints + mObstacles[i].first_point;
+    return Outline { first, first + mObstacles[i].point_count };
+}
+
+std::string ObstacleSnapshot::id(std::size_t i) const
+{
+    return std::string(mIds + mObstacles[i].id_offset, mObstacles[i].id_length);
+}
+
+SnapshotKey& SnapshotKey::add(const void* data, std::size_t length)
+{
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (std::size_t i = 0; i < length; ++i) {
+        mValue ^= bytes[i];
+        mValue *= 0x100000001b3ull;
+    }
+    return *this;
+}
+
+SnapshotKey& SnapshotKey::add(const std::string& data)
+{
+    // length prefix keeps concatenated strings distinguishable
+    const std::uint64_t length = data.size();
+    add(&length, sizeof(length));
+    return add(data.data(), data.size());
+}
+
+SnapshotKey& SnapshotKey::addFile(const std::string& file)
+{
+    std::ifstream in(file, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("cannot read " + file + " for snapshot key");
+    }
+
+    char buffer[65536];
+    while (in.read(buffer, sizeof(buffer)) || in.gcount() > 0) {
+        add(buffer, static_cast<std::size_t>(in.gcount()));
+    }
+    return *this;
+}
+
+} // namespace artery
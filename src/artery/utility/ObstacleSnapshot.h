@@ -0,0 +1,192 @@
+#ifndef ARTERY_OBSTACLESNAPSHOT_H_P4WZC8MU
+#define ARTERY_OBSTACLESNAPSHOT_H_P4WZC8MU
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace artery
+{
+
+/**
+ * ObstacleSnapshot is an immutable set of obstacle outlines along with a packed R-tree
+ *
+ * Snapshot files start with a fixed-size header followed by sections, all stored in host byte order
+ * and aligned to 8 bytes, thus a file can be memory-mapped and used without any parsing:
+ *  - obstacles: bounding box, outline point range, type index, id range and flags per obstacle
+ *  - points: outline points of all obstacles, x and y as doubles
+ *  - nodes: R-tree nodes packed by Sort-Tile-Recursive, leaves first and root last
+ *  - strings: type names (null-separated) followed by obstacle ids
+ *
+ * Obstacles are stored in R-tree leaf order, i.e. each node covers a contiguous range of obstacles
+ * or child nodes. Thus, obstacles close to each other are also stored close to each other. Simulation
+ * modules index obstacles per type on their own (see StaticObstacleLayer), the packed nodes serve
+ * inspection tools only. The header's key identifies the snapshot's origin, e.g. a checksum of the
+ * source files and filter parameters. Version, byte order or key mismatch render a snapshot stale.
+ */
+class ObstacleSnapshot
+{
+public:
+    struct Point
+    {
+        double x;
+        double y;
+    };
+
+    struct Box
+    {
+        double min_x;
+        double min_y;
+        double max_x;
+        double max_y;
+    };
+
+    struct Obstacle
+    {
+        Box box;
+        std::uint64_t first_point;
+        std::uint32_t point_count;
+        std::uint32_t type;
+        std::uint64_t id_offset;
+        std::uint32_t id_length;
+        std::uint32_t flags;
+    };
+
+    enum Flags : std::uint32_t
+    {
+        Filled = 1
+    };
+
+    struct Node
+    {
+        Box box;
+        std::uint32_t first; /*< first child node or obstacle (leaf) */
+        std::uint32_t count;
+        std::uint32_t leaf;
+        std::uint32_t reserved;
+    };
+
+    using Outline = std::pair<const Point*, const Point*>;
+
+    /**
+     * Builder collects obstacles and packs them into a snapshot
+     */
+    class Builder
+    {
+    public:
+        /**
+         * Add an obstacle
+         * \param id obstacle id
+         * \param type obstacle type, e.g. SUMO polygon type
+         * \param outline corrected and valid outline (open ring)
+         * \param flags combination of Flags
+         */
+        void add(const std::string& id, const std::string& type, std::vector<Point> outline, std::uint32_t flags = 0);
+
+        std::shared_ptr<const ObstacleSnapshot> build(std::uint64_t key) const;
+
+    private:
+        struct Entry
+        {
+            std::string id;
+            std::uint32_t type;
+            std::uint32_t flags;
+            std::vector<Point> outline;
+        };
+
+        std::vector<std::string> mTypes;
+        std::vector<Entry> mEntries;
+    };
+
+    static constexpr std::uint32_t Version = 2;
+    static constexpr std::uint32_t NodeCapacity = 16;
+
+    /**
+     * Map a snapshot file into memory
+     * \param file path of snapshot file
+     * \param key expected snapshot key
+     * \return snapshot or nullptr if file is missing or stale
+     * \throw std::runtime_error if file is corrupt
+     */
+    static std::shared_ptr<const ObstacleSnapshot> map(const std::string& file, std::uint64_t key);
+
+    /**
+     * Map a snapshot file into memory regardless of its key
+     * \return snapshot or nullptr if file is missing or of another version
+     * \throw std::runtime_error if file is corrupt
+     */
+    static std::shared_ptr<const ObstacleSnapshot> map(const std::string& file);
+
+    /**
+     * Write snapshot to file, replacing an existing file atomically
+     * \throw std::runtime_error on failure
+     */
+    void write(const std::string& file) const;
+
+    ~ObstacleSnapshot();
+    ObstacleSnapshot(const ObstacleSnapshot&) = delete;
+    ObstacleSnapshot& operator=(const ObstacleSnapshot&) = delete;
+
+    std::uint64_t key() const;
+    bool isMapped() const { return mMapping != nullptr; }
+    std::size_t size() const { return mObstacleCount; }
+    std::size_t points() const { return mPointCount; }
+    std::size_t nodes() const { return mNodeCount; }
+    std::size_t bytes() const { return mSize; }
+
+    const Obstacle& obstacle(std::size_t i) const { return mObstacles[i]; }
+    const Box& box(std::size_t i) const { return mObstacles[i].box; }
+    Outline outline(std::size_t i) const;
+    std::string id(std::size_t i) const;
+    std::uint32_t type(std::size_t i) const { return mObstacles[i].type; }
+    bool filled(std::size_t i) const { return mObstacles[i].flags & Filled; }
+    const std::vector<std::string>& types() const { return mTypes; }
+    const Node* root() const { return mNodeCount > 0 ? &mNodes[mNodeCount - 1] : nullptr; }
+    const Node& node(std::size_t i) const { return mNodes[i]; }
+
+private:
+    ObstacleSnapshot() = default;
+    void attach(const char* data, std::size_t size);
+
+    std::vector<char> mBuffer; /*< owned data if not mapped */
+    void* mMapping = nullptr;
+    std::size_t mSize = 0;
+    const char* mData = nullptr;
+    const Obstacle* mObstacles = nullptr;
+    const Point* mPoints = nullptr;
+    const Node* mNodes = nullptr;
+    const char* mIds = nullptr;
+    std::size_t mObstacleCount = 0;
+    std::size_t mPointCount = 0;
+    std::size_t mNodeCount = 0;
+    std::size_t mIdBytes = 0;
+    std::vector<std::string> mTypes;
+};
+
+/**
+ * Incremental FNV-1a checksum for snapshot keys
+ */
+class SnapshotKey
+{
+public:
+    SnapshotKey& add(const void* data, std::size_t length);
+    SnapshotKey& add(const std::string&);
+
+    /**
+     * Add file contents to checksum
+     * \throw std::runtime_error if file cannot be read
+     */
+    SnapshotKey& addFile(const std::string& file);
+
+    std::uint64_t value() const { return mValue; }
+
+private:
+    std::uint64_t mValue = 0xcbf29ce484222325ull;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_OBSTACLESNAPSHOT_H_P4WZC8MU */
@@ -0,0 +1,81 @@
+#include "artery/utility/RealtimeStatistics.h"
+#include <omnetpp/ccomponent.h>
+#include <omnetpp/cconfigoption.h>
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/cenvir.h>
+#include <omnetpp/regmacros.h>
+#include <algorithm>
+#include <string>
+
+namespace artery
+{
+
+Register_GlobalConfigOption(CFG_REALTIME_CATCH_UP_LIMIT, "realtime-catch-up-limit", CFG_INT, "0",
+        "Maximum number of overdue events a real-time scheduler dispatches back-to-back before servicing pending I/O. "
+        "Zero disables adaptive catch-up.")
+Register_GlobalConfigOptionU(CFG_REALTIME_BUSY_POLL, "realtime-busy-poll", "s", "0s",
+        "Real-time schedulers busy poll instead of sleeping if the next deadline is closer than this.")
+
+RealtimeOptions RealtimeOptions::fromConfiguration(omnetpp::cConfiguration* config)
+{
+    RealtimeOptions options;
+    options.catchUpLimit = std::max<long>(0, config->getAsInt(CFG_REALTIME_CATCH_UP_LIMIT));
+    options.busyPoll = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::duration<double>(config->getAsDouble(CFG_REALTIME_BUSY_POLL)));
+    return options;
+}
+
+RealtimeStatistics::RealtimeStatistics() :
+    mLateness("lateness")
+{
+    reset();
+}
+
+void RealtimeStatistics::reset()
+{
+    mLateness.clear();
+    mMaxLag = Clock::duration::zero();
+    mIdle = Clock::duration::zero();
+    mProcessing = Clock::duration::zero();
+    mInside = false;
+    mStarted = false;
+    mCatchUpEvents = 0;
+}
+
+void RealtimeStatistics::enterScheduler(Clock::time_point now)
+{
+    if (!mInside) {
+        if (mStarted) {
+            mProcessing += now - mLeft;
+        }
+        mEntered = now;
+        mInside = true;
+    }
+}
+
+void RealtimeStatistics::leaveScheduler(Clock::time_point now, Clock::duration lateness)
+{
+    if (mInside) {
+        mIdle += now - mEntered;
+        mInside = false;
+    }
+    mLeft = now;
+    mStarted = true;
+
+    mMaxLag = std::max(mMaxLag, lateness);
+    mLateness.collect(std::chrono::duration<double>(lateness).count());
+}
+
+void RealtimeStatistics::record(omnetpp::cComponent* component, const char* prefix)
+{
+    using seconds = std::chrono::duration<double>;
+    const std::string name = prefix;
+    auto envir = omnetpp::getEnvir();
+    envir->recordScalar(component, (name + "MaxLag").c_str(), seconds(mMaxLag).count());
+    envir->recordScalar(component, (name + "IdleTime").c_str(), seconds(mIdle).count());
+    envir->recordScalar(component, (name + "ProcessingTime").c_str(), seconds(mProcessing).count());
+    envir->recordScalar(component, (name + "CatchUpEvents").c_str(), mCatchUpEvents);
+    envir->recordStatistic(component, (name + "Lateness").c_str(), &mLateness);
+}
+
+} // namespace artery
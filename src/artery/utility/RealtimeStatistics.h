@@ -0,0 +1,85 @@
+#ifndef ARTERY_REALTIMESTATISTICS_H_FZ0BMWQ1
+#define ARTERY_REALTIMESTATISTICS_H_FZ0BMWQ1
+
+#include <omnetpp/chistogram.h>
+#include <chrono>
+
+namespace omnetpp
+{
+class cComponent;
+class cConfiguration;
+} // namespace omnetpp
+
+namespace artery
+{
+
+/**
+ * Tuning knobs shared by Artery's real-time schedulers
+ */
+struct RealtimeOptions
+{
+    /**
+     * Read options from the global configuration (realtime-* keys)
+     */
+    static RealtimeOptions fromConfiguration(omnetpp::cConfiguration*);
+
+    /**
+     * Maximum number of overdue events dispatched back-to-back before pending I/O is serviced.
+     *
+     * Both schedulers service I/O once after this many overdue events, i.e. AsioScheduler polls
+     * its sockets and TestbedScheduler flushes its OTA indication queue.
+     * Zero disables adaptive catch-up, i.e. each scheduler keeps its regular I/O handling:
+     * AsioScheduler polls before every event, whereas TestbedScheduler flushes only when
+     * the simulation is not behind wall-clock anymore.
+     */
+    unsigned catchUpLimit = 0;
+
+    /**
+     * Deadlines closer than this are awaited by busy polling instead of sleeping
+     */
+    std::chrono::nanoseconds busyPoll = std::chrono::nanoseconds::zero();
+};
+
+/**
+ * Lag statistics of a real-time scheduler
+ *
+ * Time inside takeNextEvent is accounted as idle, time between two takeNextEvent calls as processing.
+ * Lateness is the difference between the wall-clock time an event is handed out and its deadline.
+ */
+class RealtimeStatistics
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    RealtimeStatistics();
+
+    void reset();
+    void enterScheduler(Clock::time_point);
+    void leaveScheduler(Clock::time_point, Clock::duration lateness);
+    void countCatchUp() { ++mCatchUpEvents; }
+
+    Clock::duration getMaxLag() const { return mMaxLag; }
+    Clock::duration getIdleTime() const { return mIdle; }
+    Clock::duration getProcessingTime() const { return mProcessing; }
+    const omnetpp::cHistogram& getLateness() const { return mLateness; }
+
+    /**
+     * Record collected statistics as results of the given component
+     */
+    void record(omnetpp::cComponent*, const char* prefix);
+
+private:
+    omnetpp::cHistogram mLateness;
+    Clock::duration mMaxLag;
+    Clock::duration mIdle;
+    Clock::duration mProcessing;
+    Clock::time_point mEntered;
+    Clock::time_point mLeft;
+    bool mInside;
+    bool mStarted;
+    unsigned long mCatchUpEvents;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_REALTIMESTATISTICS_H_FZ0BMWQ1 */
@@ -0,0 +1,51 @@
+#include "artery/utility/SharedArtefacts.h"
+#include <omnetpp/cconfigoption.h>
+#include <omnetpp/cconfiguration.h>
+#include <omnetpp/cconfigurationex.h>
+#include <omnetpp/cenvir.h>
+#include <omnetpp/csimulation.h>
+#include <omnetpp/regmacros.h>
+
+namespace artery
+{
+
+Register_GlobalConfigOption(CFGID_SHARED_ARTEFACTS, "shared-artefacts", CFG_BOOL, "true",
+        "Share immutable scenario data such as static obstacles among all runs executed by one process.")
+
+SharedArtefacts& SharedArtefacts::instance()
+{
+    static SharedArtefacts artefacts;
+    return artefacts;
+}
+
+void SharedArtefacts::clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    mArtefacts.clear();
+}
+
+std::string SharedArtefacts::getRunId()
+{
+    omnetpp::cEnvir* envir = omnetpp::getEnvir();
+    const char* run = envir ? envir->getConfigEx()->getVariable(CFGVAR_RUNID) : nullptr;
+    return run ? run : "";
+}
+
+bool SharedArtefacts::isEnabled() const
+{
+    omnetpp::cEnvir* envir = omnetpp::getEnvir();
+    return !envir || envir->getConfig()->getAsBool(CFGID_SHARED_ARTEFACTS);
+}
+
+void SharedArtefacts::expire()
+{
+    if (!isEnabled()) {
+        std::string run = getRunId();
+        if (run != mRunId) {
+            mArtefacts.clear();
+            mRunId = std::move(run);
+        }
+    }
+}
+
+} // namespace artery
@@ -0,0 +1,104 @@
+#ifndef ARTERY_SHAREDARTEFACTS_H_L3VQ8TXD
+#define ARTERY_SHAREDARTEFACTS_H_L3VQ8TXD
+
+#include <omnetpp/cexception.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeindex>
+#include <unordered_map>
+
+namespace artery
+{
+
+/**
+ * SharedArtefacts keeps immutable scenario data for all runs executed by one process
+ *
+ * Cmdenv executes several runs in one process if given multiple run numbers, e.g. by opp_runall's
+ * batches or the artery-sweep tool. Scenario data such as obstacle polygons are identical for all
+ * replications of a configuration, thus they are built by the first run and shared by later runs.
+ * Artefacts are looked up by key, which has to identify the artefact's content completely.
+ * Sharing among runs can be disabled by the global "shared-artefacts" configuration option,
+ * artefacts are then only shared by the modules of the current run.
+ */
+class SharedArtefacts
+{
+public:
+    static SharedArtefacts& instance();
+
+    /**
+     * Get artefact of given key, build it if not available yet
+     * \param key unique artefact key
+     * \param build factory invoked without arguments returning std::shared_ptr<const T>
+     * \return artefact, never nullptr
+     */
+    template<typename T, typename F>
+    std::shared_ptr<const T> get(const std::string& key, F build)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        expire();
+
+        auto found = mArtefacts.find(key);
+        if (found == mArtefacts.end()) {
+            std::shared_ptr<const T> artefact = build();
+            if (!artefact) {
+                throw omnetpp::cRuntimeError("Building shared artefact %s failed", key.c_str());
+            }
+            found = mArtefacts.emplace(key, Artefact { typeid(T), artefact }).first;
+        } else if (found->second.type != typeid(T)) {
+            throw omnetpp::cRuntimeError("Shared artefact %s requested with mismatching type", key.c_str());
+        }
+
+        return std::static_pointer_cast<const T>(found->second.data);
+    }
+
+    /**
+     * Find artefact of given key without building it
+     * \param key unique artefact key
+     * \return artefact or nullptr if not available
+     */
+    template<typename T>
+    std::shared_ptr<const T> find(const std::string& key)
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        expire();
+
+        auto found = mArtefacts.find(key);
+        if (found == mArtefacts.end()) {
+            return nullptr;
+        } else if (found->second.type != typeid(T)) {
+            throw omnetpp::cRuntimeError("Shared artefact %s requested with mismatching type", key.c_str());
+        }
+
+        return std::static_pointer_cast<const T>(found->second.data);
+    }
+
+    /**
+     * Release all artefacts, those still in use stay valid
+     */
+    void clear();
+
+    /**
+     * Identifier of the current run, empty without simulation environment
+     */
+    static std::string getRunId();
+
+private:
+    struct Artefact
+    {
+        std::type_index type;
+        std::shared_ptr<const void> data;
+    };
+
+    SharedArtefacts() = default;
+    bool isEnabled() const;
+    void expire(); /*< drop artefacts of previous runs unless shared among runs */
+
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, Artefact> mArtefacts;
+    std::string mRunId;
+};
+
+} // namespace artery
+
+#endif /* ARTERY_SHAREDARTEFACTS_H_L3VQ8TXD */
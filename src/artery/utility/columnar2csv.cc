@@ -0,0 +1,99 @@
+/*
+ * Convert Artery's columnar result files to CSV
+ *
+ * Usage: columnar2csv INPUT [OUTPUT]
+ * CSV is written to standard output if no OUTPUT file is given.
+ */
+
+#include "artery/utility/ColumnarFormat.h"
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+using namespace artery::columnar;
+
+namespace
+{
+
+std::string quote(const std::string& field)
+{
+    if (field.find_first_of(",\"\n") == std::string::npos) {
+        return field;
+    }
+
+    std::string quoted = "\"";
+    for (char c : field) {
+        if (c == '"') {
+            quoted.push_back('"');
+        }
+        quoted.push_back(c);
+    }
+    quoted.push_back('"');
+    return quoted;
+}
+
+void convert(std::istream& in, std::ostream& out)
+{
+    Reader reader(in);
+    const double scale = std::pow(10.0, reader.getScaleExponent());
+    std::unordered_map<std::uint64_t, std::string> modules;
+    std::unordered_map<std::uint64_t, std::string> vectors; /*< vector id -> "module,name" */
+
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "module,name,event,time,value\n";
+
+    Tag tag;
+    while (reader.next(tag)) {
+        if (tag == Tag::Module) {
+            modules[reader.module().id] = quote(reader.module().path);
+        } else if (tag == Tag::Vector) {
+            const auto& vector = reader.vector();
+            vectors[vector.id] = modules.at(vector.module) + "," + quote(vector.name);
+        } else if (tag == Tag::Chunk) {
+            const Chunk& chunk = reader.chunk();
+            const std::string& prefix = vectors.at(chunk.vector);
+            for (std::size_t i = 0; i < chunk.size(); ++i) {
+                out << prefix << ',' << chunk.events[i] << ',' << chunk.times[i] * scale << ',' << chunk.values[i] << '\n';
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2 || argc > 3) {
+        std::cerr << "Usage: " << argv[0] << " INPUT [OUTPUT]\n";
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return 1;
+    }
+
+    try {
+        if (argc == 3) {
+            std::ofstream out(argv[2]);
+            if (!out) {
+                std::cerr << "Cannot open " << argv[2] << "\n";
+                return 1;
+            }
+            convert(in, out);
+        } else {
+            std::ios::sync_with_stdio(false);
+            convert(in, std::cout);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Conversion of " << argv[1] << " failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+/*
+ * Inspect obstacle snapshot files written by Artery's obstacle loader
+ *
+ * Usage: obstacle_snapshot [--list] FILE
+ * Prints summary of snapshot and validates its structure.
+ * All obstacles are listed as CSV (id, type, filled, points, bounding box) if --list is given.
+ */
+
+#include "artery/utility/ObstacleSnapshot.h"
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using artery::ObstacleSnapshot;
+
+namespace
+{
+
+std::size_t depth(const ObstacleSnapshot& snapshot)
+{
+    std::size_t levels = 0;
+    for (const ObstacleSnapshot::Node* node = snapshot.root(); node; ++levels) {
+        node = node->leaf ? nullptr : &snapshot.node(node->first);
+    }
+    return levels;
+}
+
+void summarize(const ObstacleSnapshot& snapshot, std::ostream& out)
+{
+    std::vector<std::size_t> types(snapshot.types().size(), 0);
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        ++types[snapshot.type(i)];
+    }
+
+    out << "version: " << ObstacleSnapshot::Version << "\n";
+    out << "key: " << std::hex << snapshot.key() << std::dec << "\n";
+    out << "bytes: " << snapshot.bytes() << "\n";
+    out << "obstacles: " << snapshot.size() << "\n";
+    out << "points: " << snapshot.points() << "\n";
+    out << "nodes: " << snapshot.nodes() << " (depth " << depth(snapshot) << ")\n";
+    if (const ObstacleSnapshot::Node* root = snapshot.root()) {
+        const auto& box = root->box;
+        out << "bounds: " << box.min_x << " " << box.min_y << " " << box.max_x << " " << box.max_y << "\n";
+    }
+    for (std::size_t type = 0; type < types.size(); ++type) {
+        out << "type " << snapshot.types()[type] << ": " << types[type] << "\n";
+    }
+}
+
+void list(const ObstacleSnapshot& snapshot, std::ostream& out)
+{
+    out.precision(std::numeric_limits<double>::max_digits10);
+    out << "id,type,filled,points,min_x,min_y,max_x,max_y\n";
+    for (std::size_t i = 0; i < snapshot.size(); ++i) {
+        const auto& box = snapshot.box(i);
+        out << snapshot.id(i) << ',' << snapshot.types()[snapshot.type(i)] << ',' << snapshot.filled(i);
+        out << ',' << snapshot.obstacle(i).point_count;
+        out << ',' << box.min_x << ',' << box.min_y << ',' << box.max_x << ',' << box.max_y << '\n';
+    }
+}
+
+} // namespace
+
+int main(int argc, const char** argv)
+{
+    const bool listing = argc == 3 && std::strcmp(argv[1], "--list") == 0;
+    if (argc != 2 && !listing) {
+        std::cerr << "Usage: " << argv[0] << " [--list] FILE\n";
+        return 1;
+    }
+
+    const char* file = argv[argc - 1];
+    try {
+        auto snapshot = ObstacleSnapshot::map(file);
+        if (!snapshot) {
+            std::cerr << file << " is missing or of another snapshot version\n";
+            return 1;
+        }
+
+        if (listing) {
+            std::ios::sync_with_stdio(false);
+            list(*snapshot, std::cout);
+        } else {
+            summarize(*snapshot, std::cout);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Reading " << file << " failed: " << e.what() << "\n";
+        return 1;
+    }
+
+    return 0;
+}
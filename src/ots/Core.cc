@@ -46,6 +46,8 @@ const simsignal_t lifecycle_signal = cComponent::registerSignal("ots-lifecycle")
 const simsignal_t gtu_add_signal = cComponent::registerSignal("ots-gtu-add");
 const simsignal_t gtu_remove_signal = cComponent::registerSignal("ots-gtu-remove");
 const simsignal_t gtu_position_signal = cComponent::registerSignal("ots-gtu-position");
+const simsignal_t round_trips_signal = cComponent::registerSignal("ots-round-trips");
+const simsignal_t decode_time_signal = cComponent::registerSignal("ots-decode-time");
 
 bool isGoodReply(const sim0mqpp::Message& msg)
 {
@@ -111,6 +113,15 @@ void Core::initialize()
 
     m_stop_time = par("otsRunDuration");
     m_sync_time_notification = par("syncTimeOnNotification");
+
+    const std::string gtu_query = par("gtuPositionQuery").stdstringValue();
+    if (gtu_query == "pipelined") {
+        m_pipeline_gtu_queries = true;
+    } else if (gtu_query == "sequential") {
+        m_pipeline_gtu_queries = false;
+    } else {
+        throw omnetpp::cRuntimeError("unknown GTU position query mode \"%s\"", gtu_query.c_str());
+    }
 }
 
 void Core::handleMessage(omnetpp::cMessage* msg)
@@ -140,6 +151,11 @@ void Core::handleMessage(omnetpp::cMessage* msg)
 
             // request positions of all GTUs at current time step
             requestGtuPositions();
+
+            emit(round_trips_signal, m_step_round_trips);
+            emit(decode_time_signal, std::chrono::duration<double>(m_step_decode_time).count());
+            m_step_round_trips = 0;
+            m_step_decode_time = std::chrono::steady_clock::duration::zero();
         } else {
             // end of OTS simulation reached
             emit(lifecycle_signal, false);
@@ -167,22 +183,25 @@ void Core::unregisterRadio(const RadioEndpoint* radio)
     }
 }
 
-bool Core::receive(std::size_t maxlen, bool block)
+bool Core::receive(bool block)
 {
-    m_buffer.resize(maxlen);
-    int length = zmq_recv(m_zmq_socket, m_buffer.data(), m_buffer.size(), block ? 0 : ZMQ_NOBLOCK);
+    // zmq_msg_t avoids guessing a maximum length, copying into m_buffer reuses its capacity
+    zmq_msg_t zmq_msg;
+    zmq_msg_init(&zmq_msg);
+    int length = zmq_msg_recv(&zmq_msg, m_zmq_socket, block ? 0 : ZMQ_NOBLOCK);
     if (length < 0) {
-        if (!block && errno == EAGAIN) {
+        const int error = errno;
+        zmq_msg_close(&zmq_msg);
+        if (!block && error == EAGAIN) {
             return false;
         } else {
-            throw omnetpp::cRuntimeError("Receiving from OTS endpoint failed: %s", zmq_strerror(errno));
+            throw omnetpp::cRuntimeError("Receiving from OTS endpoint failed: %s", zmq_strerror(error));
         }
-    } else if (length > m_buffer.size()) {
-        throw omnetpp::cRuntimeError("Length of replied message exceeds buffer size");
-    } else {
-        m_buffer.resize(length);
     }
 
+    const auto* data = static_cast<const std::uint8_t*>(zmq_msg_data(&zmq_msg));
+    m_buffer.assign(data, data + zmq_msg_size(&zmq_msg));
+    zmq_msg_close(&zmq_msg);
     return true;
 }
 
@@ -226,10 +245,13 @@ void Core::sendCommand(const sim0mqpp::Identifier& cmd, std::int32_t cmd_id, std
 void Core::queryResponses(const sim0mqpp::Identifier& wait_for)
 {
     m_pending.insert(wait_for);
-    while (receive(8192, !m_pending.empty())) {
+    ++m_step_round_trips;
+    while (receive(!m_pending.empty() || m_pending_gtu_moves > 0)) {
+        const auto decode_start = std::chrono::steady_clock::now();
         sim0mqpp::BufferDeserializer input(m_buffer);
         sim0mqpp::Message msg;
         deserialize(input, msg);
+        m_step_decode_time += std::chrono::steady_clock::now() - decode_start;
         if (input.good()) {
             m_pending.erase(msg.message_type_id);
 
@@ -238,6 +260,9 @@ void Core::queryResponses(const sim0mqpp::Identifier& wait_for)
             } else if (msg.message_type_id == sim_state_msg) {
                 processSimulationChange(msg);
             } else if (msg.message_type_id == gtu_move_msg) {
+                if (m_pending_gtu_moves > 0) {
+                    --m_pending_gtu_moves;
+                }
                 processGtuMove(msg);
             } else if (msg.message_type_id == radio_transmit_msg) {
                 processRadio(msg);
@@ -287,8 +312,16 @@ void Core::processNetwork(const sim0mqpp::Message& msg)
     }
 
     if (*msg_id == 0) {
-        for (const auto& gtu_id : msg.payload) {
-            requestGtuPosition(gtu_id);
+        if (m_pipeline_gtu_queries) {
+            // replies are drained by the ongoing queryResponses loop
+            for (const auto& gtu_id : msg.payload) {
+                sendGtuPositionRequest(gtu_id);
+                ++m_pending_gtu_moves;
+            }
+        } else {
+            for (const auto& gtu_id : msg.payload) {
+                requestGtuPosition(gtu_id);
+            }
         }
     } else if (*msg_id == gtu_add_subscription) {
         if (m_gtu_add_subscribed) {
@@ -476,11 +509,16 @@ void Core::requestGtuPositions()
 }
 
 void Core::requestGtuPosition(const sim0mqpp::Any& gtu_id)
+{
+    sendGtuPositionRequest(gtu_id);
+    queryResponses(gtu_move_msg);
+}
+
+void Core::sendGtuPositionRequest(const sim0mqpp::Any& gtu_id)
 {
     std::vector<sim0mqpp::Any> payload;
     payload.push_back(gtu_id);
     sendCommand(gtu_move_get_current_msg, std::move(payload));
-    queryResponses(gtu_move_msg);
 }
 
 void Core::notifyRadioReception(const RadioMessage& msg)
@@ -4,6 +4,7 @@
 #include <omnetpp/csimplemodule.h>
 #include <sim0mqpp/any.hpp>
 #include <sim0mqpp/message.hpp>
+#include <chrono>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -39,8 +40,9 @@ protected:
     void simulateUntil(omnetpp::SimTime);
     void requestGtuPositions();
     void requestGtuPosition(const sim0mqpp::Any&);
+    void sendGtuPositionRequest(const sim0mqpp::Any&);
 
-    bool receive(std::size_t maxlen, bool block = true);
+    bool receive(bool block = true);
     void queryResponses(const sim0mqpp::Identifier&);
     void processNetwork(const sim0mqpp::Message&);
     void processGtuMove(const sim0mqpp::Message&);
@@ -67,6 +69,10 @@ private:
     std::string m_sim_receiver;
     std::vector<std::uint8_t> m_buffer;
     std::unordered_set<sim0mqpp::Identifier> m_pending;
+    bool m_pipeline_gtu_queries = true; /* send all GTU position requests before awaiting any reply */
+    std::size_t m_pending_gtu_moves = 0;
+    long m_step_round_trips = 0;
+    std::chrono::steady_clock::duration m_step_decode_time = std::chrono::steady_clock::duration::zero();
     bool m_gtu_add_subscribed = false;
     bool m_gtu_remove_subscribed = false;
     bool m_sim_state_subscribed = false;
@@ -1,5 +1,11 @@
 #include "traci/API.h"
 #include "traci/Launcher.h"
+#include <omnetpp/ccomponent.h>
+#include <omnetpp/cexception.h>
+#include <omnetpp/cmodule.h>
+#include <omnetpp/csimulation.h>
+#include <algorithm>
+#include <cmath>
 #include <thread>
 
 namespace traci
@@ -7,6 +13,12 @@ namespace traci
 
 TraCIGeoPosition API::convertGeo(const TraCIPosition& pos) const
 {
+    if (m_projection.isEnabled()) {
+        TraCIGeoPosition geo = m_projection.convertGeo(pos);
+        sampleGeoProjection(pos, geo);
+        return geo;
+    }
+
     libsumo::TraCIPosition result = simulation.convertGeo(pos.x, pos.y, false);
     TraCIGeoPosition geo;
     geo.longitude = result.x;
@@ -16,9 +28,54 @@ TraCIGeoPosition API::convertGeo(const TraCIPosition& pos) const
 
 TraCIPosition API::convert2D(const TraCIGeoPosition& pos) const
 {
+    if (m_projection.isEnabled()) {
+        TraCIPosition result = m_projection.convert2D(pos);
+        if (isGeoSampleDue()) {
+            const TraCIPosition sample = simulation.convertGeo(pos.longitude, pos.latitude, true);
+            recordGeoError(std::hypot(result.x - sample.x, result.y - sample.y));
+        }
+        return result;
+    }
+
     return simulation.convertGeo(pos.longitude, pos.latitude, true);
 }
 
+void API::setGeoProjectionSampling(unsigned interval, double tolerance)
+{
+    m_projectionSampling = interval;
+    m_projectionTolerance = tolerance;
+}
+
+void API::sampleGeoProjection(const TraCIPosition& pos, const TraCIGeoPosition& geo) const
+{
+    if (isGeoSampleDue()) {
+        // measure deviation in network coordinates like Core does when loading the projection
+        const libsumo::TraCIPosition sample = simulation.convertGeo(pos.x, pos.y, false);
+        TraCIGeoPosition expected;
+        expected.longitude = sample.x;
+        expected.latitude = sample.y;
+        const TraCIPosition a = m_projection.convert2D(geo);
+        const TraCIPosition b = m_projection.convert2D(expected);
+        recordGeoError(std::hypot(a.x - b.x, a.y - b.y));
+    }
+}
+
+bool API::isGeoSampleDue() const
+{
+    ++m_projectionStatistics.conversions;
+    return m_projectionSampling > 0 && m_projectionStatistics.conversions % m_projectionSampling == 0;
+}
+
+void API::recordGeoError(double error) const
+{
+    ++m_projectionStatistics.samples;
+    m_projectionStatistics.maxError = std::max(m_projectionStatistics.maxError, error);
+    if (error > m_projectionTolerance) {
+        throw omnetpp::cRuntimeError("local geo projection deviates %f m from TraCI (tolerance %f m)",
+                error, m_projectionTolerance);
+    }
+}
+
 void API::connect(const ServerEndpoint& endpoint)
 {
     const unsigned max_tries = endpoint.retry ? 10 : 0;
@@ -41,4 +98,139 @@ void API::connect(const ServerEndpoint& endpoint)
     }
 }
 
+void API::queueCommand(int cmdId, int varId, const std::string& objId, tcpip::Storage& content)
+{
+    ++m_statistics.queued;
+    if (!m_batching) {
+        createCommand(cmdId, varId, objId, &content);
+        processSet(cmdId);
+        ++m_statistics.sent;
+        return;
+    }
+
+    omnetpp::cModule* context = omnetpp::getSimulation()->getContextModule();
+    QueuedCommand command { cmdId, varId, objId, { content.begin(), content.end() },
+        context ? context->getId() : -1, false };
+
+    // command and variable identifiers are single bytes in TraCI messages
+    std::string key;
+    key.reserve(objId.size() + 2);
+    key.push_back(static_cast<char>(cmdId));
+    key.push_back(static_cast<char>(varId));
+    key.append(objId);
+
+    // superseded commands are skipped at flush, thus the latest command keeps its issuing order
+    auto pending = m_pendingCommands.emplace(std::move(key), m_commands.size());
+    if (!pending.second) {
+        m_commands[pending.first->second].superseded = true;
+        pending.first->second = m_commands.size();
+        ++m_statistics.coalesced;
+    }
+    m_commands.push_back(std::move(command));
+}
+
+void API::queueDouble(int cmdId, int varId, const std::string& objId, double value)
+{
+    tcpip::Storage content;
+    content.writeUnsignedByte(libsumo::TYPE_DOUBLE);
+    content.writeDouble(value);
+    queueCommand(cmdId, varId, objId, content);
+}
+
+void API::queueInt(int cmdId, int varId, const std::string& objId, int value)
+{
+    tcpip::Storage content;
+    content.writeUnsignedByte(libsumo::TYPE_INTEGER);
+    content.writeInt(value);
+    queueCommand(cmdId, varId, objId, content);
+}
+
+void API::queueString(int cmdId, int varId, const std::string& objId, const std::string& value)
+{
+    tcpip::Storage content;
+    content.writeUnsignedByte(libsumo::TYPE_STRING);
+    content.writeString(value);
+    queueCommand(cmdId, varId, objId, content);
+}
+
+void API::flushCommands()
+{
+    if (m_commands.empty()) {
+        return;
+    } else if (!mySocket) {
+        discardCommands();
+        return;
+    }
+
+    // same command layout as TraCIAPI::createCommand, but all commands in one message
+    m_batch.reset();
+    std::size_t count = 0;
+    for (QueuedCommand& command : m_commands) {
+        if (command.superseded) {
+            continue;
+        }
+        const int length = 1 + 1 + 1 + 4 + static_cast<int>(command.objId.length()) + static_cast<int>(command.content.size());
+        if (length <= 255) {
+            m_batch.writeUnsignedByte(length);
+        } else {
+            m_batch.writeUnsignedByte(0);
+            m_batch.writeInt(length + 4);
+        }
+        m_batch.writeUnsignedByte(command.cmdId);
+        m_batch.writeUnsignedByte(command.varId);
+        m_batch.writeString(command.objId);
+        m_batch.writePacket(command.content);
+        ++count;
+    }
+    mySocket->sendExact(m_batch);
+    ++m_statistics.batches;
+    m_statistics.sent += count;
+
+    // server answers with one status response per command in order of commands
+    myInput.reset();
+    mySocket->receiveExact(myInput);
+    const QueuedCommand* failed = nullptr;
+    std::string failure;
+    unsigned failures = 0;
+    for (const QueuedCommand& command : m_commands) {
+        if (command.superseded) {
+            continue;
+        }
+        const int start = myInput.position();
+        int length = myInput.readUnsignedByte();
+        if (length == 0) {
+            length = myInput.readInt();
+        }
+        const int cmdId = myInput.readUnsignedByte();
+        const int result = myInput.readUnsignedByte();
+        std::string description = myInput.readString();
+        if (cmdId != command.cmdId || start + length != static_cast<int>(myInput.position())) {
+            discardCommands();
+            throw omnetpp::cRuntimeError("malformed TraCI status response in command batch");
+        } else if (result != libsumo::RTYPE_OK && !failed) {
+            failed = &command;
+            failure = std::move(description);
+        }
+        failures += result != libsumo::RTYPE_OK ? 1 : 0;
+    }
+
+    if (failed) {
+        omnetpp::cComponent* issuer = omnetpp::getSimulation()->getComponent(failed->issuer);
+        const std::string issuerPath = issuer ? issuer->getFullPath() : "unknown module";
+        const int cmdId = failed->cmdId;
+        const int varId = failed->varId;
+        const std::string objId = failed->objId;
+        discardCommands();
+        throw omnetpp::cRuntimeError("TraCI command 0x%02x (variable 0x%02x) for \"%s\" issued by %s failed: %s (%u of %zu commands failed)",
+                cmdId, varId, objId.c_str(), issuerPath.c_str(), failure.c_str(), failures, count);
+    }
+    discardCommands();
+}
+
+void API::discardCommands()
+{
+    m_commands.clear();
+    m_pendingCommands.clear();
+}
+
 } // namespace traci
@@ -5,9 +5,13 @@
 #include "traci/Angle.h"
 #include "traci/Boundary.h"
 #include "traci/GeoPosition.h"
+#include "traci/GeoProjection.h"
 #include "traci/Position.h"
 #include "traci/Time.h"
 #include <omnetpp/simtime.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace traci
 {
@@ -19,10 +23,110 @@ class API : public TraCIAPI
 public:
     using Version = std::pair<int, std::string>;
 
+    /**
+     * Convert between network and geodetic positions
+     *
+     * Conversions are done locally if a geo projection is set, otherwise TraCI is queried.
+     */
     TraCIGeoPosition convertGeo(const TraCIPosition&) const;
     TraCIPosition convert2D(const TraCIGeoPosition&) const;
 
     void connect(const ServerEndpoint&);
+
+    /**
+     * Local replica of SUMO's network projection
+     * \return projection, which is disabled unless set explicitly
+     */
+    const GeoProjection& getGeoProjection() const { return m_projection; }
+    void setGeoProjection(const GeoProjection& projection) { m_projection = projection; }
+
+    struct GeoProjectionStatistics
+    {
+        unsigned long conversions = 0; /*< local conversions */
+        unsigned long samples = 0; /*< local conversions verified by TraCI */
+        double maxError = 0.0; /*< maximum deviation of samples in metres */
+    };
+
+    /**
+     * Verify local geo projection by TraCI conversion of every n-th converted position
+     *
+     * \param interval sampling interval, 0 disables verification
+     * \param tolerance maximum deviation (in metres) before verification fails
+     */
+    void setGeoProjectionSampling(unsigned interval, double tolerance);
+
+    /**
+     * Account for a position converted locally outside of convertGeo, e.g. in a batch
+     *
+     * \param pos network position
+     * \param geo locally converted geodetic position
+     */
+    void sampleGeoProjection(const TraCIPosition& pos, const TraCIGeoPosition& geo) const;
+
+    const GeoProjectionStatistics& getGeoProjectionStatistics() const { return m_projectionStatistics; }
+
+    struct CommandStatistics
+    {
+        unsigned long queued = 0; /*< set commands issued via queue */
+        unsigned long coalesced = 0; /*< commands superseded by a later command before flush */
+        unsigned long sent = 0; /*< commands actually sent to TraCI server */
+        unsigned long batches = 0; /*< number of flushed batches */
+    };
+
+    /**
+     * Queue a set command until the next flush, i.e. the next simulation step
+     *
+     * A queued command replaces any pending command for the same object and variable,
+     * thus only commands whose last issued value wins are suitable for queueing.
+     * Status responses are checked at flush, failures are attributed to the issuing module.
+     * Commands are sent immediately if batching is disabled.
+     *
+     * \param cmdId set command of domain, e.g. CMD_SET_VEHICLE_VARIABLE
+     * \param varId variable to be set
+     * \param objId object identifier
+     * \param content typed value of command
+     */
+    void queueCommand(int cmdId, int varId, const std::string& objId, tcpip::Storage& content);
+    void queueDouble(int cmdId, int varId, const std::string& objId, double value);
+    void queueInt(int cmdId, int varId, const std::string& objId, int value);
+    void queueString(int cmdId, int varId, const std::string& objId, const std::string& value);
+
+    /**
+     * Send all queued commands as one TraCI message and check their results
+     */
+    void flushCommands();
+
+    /**
+     * Drop all queued commands without sending them
+     */
+    void discardCommands();
+
+    void setCommandBatching(bool enable) { m_batching = enable; }
+    const CommandStatistics& getCommandStatistics() const { return m_statistics; }
+
+private:
+    bool isGeoSampleDue() const;
+    void recordGeoError(double error) const;
+
+    struct QueuedCommand
+    {
+        int cmdId;
+        int varId;
+        std::string objId;
+        std::vector<unsigned char> content; /*< copy of typed value, storages are not copyable */
+        int issuer; /*< id of context module when command was queued */
+        bool superseded;
+    };
+
+    GeoProjection m_projection;
+    unsigned m_projectionSampling = 0;
+    double m_projectionTolerance = 0.0;
+    mutable GeoProjectionStatistics m_projectionStatistics;
+    bool m_batching = true;
+    std::vector<QueuedCommand> m_commands;
+    std::unordered_map<std::string, std::size_t> m_pendingCommands; /*< command key -> index in m_commands */
+    tcpip::Storage m_batch;
+    CommandStatistics m_statistics;
 };
 
 } // namespace traci
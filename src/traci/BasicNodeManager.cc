@@ -156,6 +156,8 @@ void BasicNodeManager::processVehicles()
         }
     }
 
+    projectVehicles();
+
     for (auto& vehicle : m_vehicles) {
         const std::string& id = vehicle.first;
         VehicleSink* sink = vehicle.second;
@@ -163,6 +165,35 @@ void BasicNodeManager::processVehicles()
     }
 }
 
+void BasicNodeManager::projectVehicles()
+{
+    const GeoProjection& projection = m_api->getGeoProjection();
+    if (!projection.isEnabled()) {
+        return;
+    }
+
+    // convert positions in one pass before vehicles get updated,
+    // only vehicles whose geodetic positions have been requested since the last pass are included
+    m_projection_caches.clear();
+    m_projection_input.clear();
+    for (auto& vehicle : m_vehicles) {
+        auto cache = m_subscriptions->getVehicleCache(vehicle.first);
+        if (!cache->isGeoPositionRequested()) {
+            continue;
+        }
+        m_projection_input.push_back(cache->get<libsumo::VAR_POSITION>());
+        m_projection_caches.push_back(std::move(cache));
+    }
+
+    m_projection_output.resize(m_projection_input.size());
+    const TraCIPosition* input = m_projection_input.data();
+    projection.convertGeo(input, input + m_projection_input.size(), m_projection_output.data());
+    for (std::size_t i = 0; i < m_projection_caches.size(); ++i) {
+        m_projection_caches[i]->setGeoPosition(m_projection_output[i]);
+        m_api->sampleGeoProjection(m_projection_input[i], m_projection_output[i]);
+    }
+}
+
 void BasicNodeManager::addVehicle(const std::string& id)
 {
     NodeInitializer init = [this, &id](cModule* module) {
@@ -3,6 +3,7 @@
 
 #include "traci/Angle.h"
 #include "traci/Boundary.h"
+#include "traci/GeoPosition.h"
 #include "traci/NodeManager.h"
 #include "traci/Listener.h"
 #include "traci/Position.h"
@@ -13,6 +14,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace traci
 {
@@ -85,6 +87,7 @@ protected:
     virtual VehicleSink* getVehicleSink(const std::string&);
     virtual void processPersons();
     virtual void processVehicles();
+    virtual void projectVehicles();
 
     void traciInit() override;
     void traciStep() override;
@@ -104,6 +107,9 @@ private:
     bool m_destroy_vehicles_on_crash;
     bool m_ignore_persons;
     omnetpp::SimTime m_offset = omnetpp::SimTime::ZERO;
+    std::vector<std::shared_ptr<VehicleCache>> m_projection_caches;
+    std::vector<TraCIPosition> m_projection_input;
+    std::vector<TraCIGeoPosition> m_projection_output;
 };
 
 } // namespace traci
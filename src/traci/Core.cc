@@ -3,7 +3,11 @@
 #include "traci/API.h"
 #include "traci/SubscriptionManager.h"
 #include <inet/common/ModuleAccess.h>
+#include <algorithm>
+#include <cmath>
 #include <limits>
+#include <string>
+#include <vector>
 
 Define_Module(traci::Core)
 
@@ -38,6 +42,7 @@ void Core::initialize()
     cModule* manager = getParentModule();
     m_launcher = inet::getModuleFromPar<Launcher>(par("launcherModule"), manager);
     m_stopping = par("selfStopping");
+    m_traci->setCommandBatching(par("batchCommands"));
     scheduleAt(par("startTime"), m_connectEvent);
     m_subscriptions = inet::getModuleFromPar<SubscriptionManager>(par("subscriptionsModule"), manager, false);
 }
@@ -46,13 +51,28 @@ void Core::finish()
 {
     emit(closeSignal, simTime());
     if (!m_connectEvent->isScheduled()) {
+        // commands queued after the last step would take effect in no step anymore
+        m_traci->discardCommands();
         m_traci->close();
     }
+
+    const API::CommandStatistics& commands = m_traci->getCommandStatistics();
+    recordScalar("commandsQueued", commands.queued);
+    recordScalar("commandsCoalesced", commands.coalesced);
+    recordScalar("commandsSent", commands.sent);
+    recordScalar("commandBatches", commands.batches);
+
+    const API::GeoProjectionStatistics& projection = m_traci->getGeoProjectionStatistics();
+    if (projection.samples > 0) {
+        recordScalar("geoProjectionSamples", projection.samples);
+        recordScalar("geoProjectionMaxError", projection.maxError, "m");
+    }
 }
 
 void Core::handleMessage(cMessage* msg)
 {
     if (msg == m_updateEvent) {
+        m_traci->flushCommands();
         m_traci->simulationStep();
         if (m_subscriptions) {
             m_subscriptions->step();
@@ -66,6 +86,7 @@ void Core::handleMessage(cMessage* msg)
         m_traci->connect(m_launcher->launch());
         checkVersion();
         syncTime();
+        loadGeoProjection();
         emit(initSignal, simTime());
         m_updateInterval = Time { m_traci->simulation.getDeltaT() };
         scheduleAt(simTime() + m_updateInterval, m_updateEvent);
@@ -103,6 +124,77 @@ void Core::syncTime()
     }
 }
 
+void Core::loadGeoProjection()
+{
+    const std::string parameter = par("geoProjection").stdstringValue();
+    if (parameter.empty()) {
+        return;
+    }
+
+    // TraCI does not report the network's location element, thus it is derived from
+    // TraCI conversions at corners and center of network
+    const Boundary boundary { m_traci->simulation.getNetBoundary() };
+    const TraCIPosition& ll = boundary.lowerLeftPosition();
+    const TraCIPosition& ur = boundary.upperRightPosition();
+    std::vector<TraCIPosition> samples;
+    std::vector<TraCIGeoPosition> references;
+    for (double fx : { 0.5, 0.0, 1.0 }) {
+        for (double fy : { 0.5, 0.0, 1.0 }) {
+            TraCIPosition sample;
+            sample.x = ll.x + fx * (ur.x - ll.x);
+            sample.y = ll.y + fy * (ur.y - ll.y);
+            samples.push_back(sample);
+            references.push_back(m_traci->convertGeo(sample));
+        }
+    }
+
+    std::vector<std::string> candidates;
+    if (parameter == "auto") {
+        const TraCIGeoPosition& center = references.front();
+        if (std::abs(center.longitude) <= 180.0 && std::abs(center.latitude) <= 84.0) {
+            const int zone = std::min(60, static_cast<int>(std::floor((center.longitude + 180.0) / 6.0)) + 1);
+            candidates.push_back("+proj=utm +zone=" + std::to_string(zone) + (center.latitude < 0.0 ? " +south" : ""));
+        }
+        candidates.push_back("+proj=tmerc");
+        candidates.push_back("!");
+    } else {
+        candidates.push_back(parameter);
+    }
+
+    const double tolerance = par("geoProjectionTolerance");
+    double maxError = std::numeric_limits<double>::infinity();
+    for (const std::string& candidate : candidates) {
+        GeoProjection projection = GeoProjection::fromReference(candidate, samples.front(), references.front());
+        if (!projection.isEnabled()) {
+            throw cRuntimeError("unsupported SUMO projection \"%s\"", candidate.c_str());
+        }
+
+        maxError = 0.0;
+        for (std::size_t i = 0; i < samples.size(); ++i) {
+            const TraCIPosition local = projection.convert2D(references[i]);
+            maxError = std::max(maxError, std::hypot(local.x - samples[i].x, local.y - samples[i].y));
+        }
+
+        if (maxError <= tolerance) {
+            EV_INFO << "local geo projection \"" << candidate << "\" deviates at most " << maxError << " m from TraCI" << endl;
+            m_traci->setGeoProjection(projection);
+
+            const int sampling = par("geoProjectionSampling");
+            if (sampling < 0) {
+                throw cRuntimeError("geoProjectionSampling must not be negative");
+            }
+            m_traci->setGeoProjectionSampling(sampling, tolerance);
+            return;
+        }
+        EV_DEBUG << "geo projection \"" << candidate << "\" deviates " << maxError << " m from TraCI" << endl;
+    }
+
+    if (parameter != "auto") {
+        throw cRuntimeError("local geo projection deviates %f m from TraCI (tolerance %f m)", maxError, tolerance);
+    }
+    EV_WARN << "SUMO projection is not identified, falling back to TraCI conversion" << endl;
+}
+
 std::shared_ptr<API> Core::getAPI()
 {
     return m_traci;
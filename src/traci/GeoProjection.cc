@@ -0,0 +1,257 @@
+#include "traci/GeoProjection.h"
+#include <boost/lexical_cast.hpp>
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+namespace traci
+{
+
+namespace
+{
+
+constexpr double pi = 3.14159265358979323846;
+constexpr double deg2rad = pi / 180.0;
+constexpr double rad2deg = 180.0 / pi;
+
+// WGS84 ellipsoid, GRS80 differs only by 0.1 mm in semi-minor axis
+constexpr double semiMajorAxis = 6378137.0;
+constexpr double flattening = 1.0 / 298.257223563;
+
+using ProjParameters = std::map<std::string, std::string>;
+
+ProjParameters parseProjParameter(const std::string& str)
+{
+    ProjParameters params;
+    std::istringstream stream(str);
+    std::string token;
+    while (stream >> token) {
+        if (token.front() == '+') {
+            token.erase(0, 1);
+        }
+        auto equal = token.find('=');
+        if (equal == std::string::npos) {
+            params.emplace(token, "");
+        } else {
+            params.emplace(token.substr(0, equal), token.substr(equal + 1));
+        }
+    }
+    return params;
+}
+
+double getParameter(const ProjParameters& params, const std::string& key, double fallback)
+{
+    auto found = params.find(key);
+    return found != params.end() ? boost::lexical_cast<double>(found->second) : fallback;
+}
+
+} // namespace
+
+
+constexpr std::size_t GeoProjection::Order;
+
+GeoProjection::GeoProjection() :
+    m_method(Method::Disabled), m_offsetX(0.0), m_offsetY(0.0),
+    m_lon0(0.0), m_falseEasting(0.0), m_falseNorthing(0.0), m_scale(1.0), m_xi0(0.0), m_e(0.0),
+    m_alpha {}, m_beta {}
+{
+}
+
+GeoProjection GeoProjection::fromLocation(const std::string& netOffset, const std::string& projParameter)
+{
+    GeoProjection projection;
+
+    const auto comma = netOffset.find(',');
+    if (comma == std::string::npos) {
+        return projection;
+    }
+
+    try {
+        projection.m_offsetX = boost::lexical_cast<double>(netOffset.substr(0, comma));
+        projection.m_offsetY = boost::lexical_cast<double>(netOffset.substr(comma + 1));
+
+        if (projParameter == "!") {
+            projection.m_method = Method::Offset;
+            return projection;
+        }
+
+        const ProjParameters params = parseProjParameter(projParameter);
+        auto ellps = params.find("ellps");
+        if (ellps != params.end() && ellps->second != "WGS84" && ellps->second != "GRS80") {
+            return projection;
+        } else if (params.count("units") && params.at("units") != "m") {
+            return projection;
+        }
+
+        auto proj = params.find("proj");
+        if (proj == params.end()) {
+            return projection;
+        } else if (proj->second == "utm") {
+            const double zone = getParameter(params, "zone", 0.0);
+            if (zone < 1.0 || zone > 60.0) {
+                return projection;
+            }
+            const double lon0 = zone * 6.0 - 183.0;
+            const double y0 = params.count("south") ? 10000000.0 : 0.0;
+            projection.setupTransverseMercator(0.0, lon0, 0.9996, 500000.0, y0);
+        } else if (proj->second == "tmerc") {
+            const double lat0 = getParameter(params, "lat_0", 0.0);
+            const double lon0 = getParameter(params, "lon_0", 0.0);
+            const double k0 = getParameter(params, "k_0", getParameter(params, "k", 1.0));
+            const double x0 = getParameter(params, "x_0", 0.0);
+            const double y0 = getParameter(params, "y_0", 0.0);
+            projection.setupTransverseMercator(lat0, lon0, k0, x0, y0);
+        }
+    } catch (const boost::bad_lexical_cast&) {
+        projection.m_method = Method::Disabled;
+    }
+
+    return projection;
+}
+
+GeoProjection GeoProjection::fromReference(const std::string& projParameter, const TraCIPosition& pos, const TraCIGeoPosition& geo)
+{
+    GeoProjection projection = fromLocation("0,0", projParameter);
+    if (projection.isEnabled()) {
+        // network positions are projected positions shifted by net offset
+        const TraCIPosition projected = projection.convert2D(geo);
+        projection.m_offsetX = pos.x - projected.x;
+        projection.m_offsetY = pos.y - projected.y;
+    }
+    return projection;
+}
+
+void GeoProjection::setupTransverseMercator(double lat0, double lon0, double k0, double x0, double y0)
+{
+    const double n = flattening / (2.0 - flattening);
+    const double n2 = n * n;
+    const double n3 = n2 * n;
+    const double n4 = n3 * n;
+    const double n5 = n4 * n;
+    const double n6 = n5 * n;
+
+    // Krüger series coefficients, see Karney (2011): "Transverse Mercator with an accuracy of a few nanometers"
+    m_alpha[0] = n / 2.0 - 2.0 * n2 / 3.0 + 5.0 * n3 / 16.0 + 41.0 * n4 / 180.0 - 127.0 * n5 / 288.0 + 7891.0 * n6 / 37800.0;
+    m_alpha[1] = 13.0 * n2 / 48.0 - 3.0 * n3 / 5.0 + 557.0 * n4 / 1440.0 + 281.0 * n5 / 630.0 - 1983433.0 * n6 / 1935360.0;
+    m_alpha[2] = 61.0 * n3 / 240.0 - 103.0 * n4 / 140.0 + 15061.0 * n5 / 26880.0 + 167603.0 * n6 / 181440.0;
+    m_alpha[3] = 49561.0 * n4 / 161280.0 - 179.0 * n5 / 168.0 + 6601661.0 * n6 / 7257600.0;
+    m_alpha[4] = 34729.0 * n5 / 80640.0 - 3418889.0 * n6 / 1995840.0;
+    m_alpha[5] = 212378941.0 * n6 / 319334400.0;
+
+    m_beta[0] = n / 2.0 - 2.0 * n2 / 3.0 + 37.0 * n3 / 96.0 - n4 / 360.0 - 81.0 * n5 / 512.0 + 96199.0 * n6 / 604800.0;
+    m_beta[1] = n2 / 48.0 + n3 / 15.0 - 437.0 * n4 / 1440.0 + 46.0 * n5 / 105.0 - 1118711.0 * n6 / 3870720.0;
+    m_beta[2] = 17.0 * n3 / 480.0 - 37.0 * n4 / 840.0 - 209.0 * n5 / 4480.0 + 5569.0 * n6 / 90720.0;
+    m_beta[3] = 4397.0 * n4 / 161280.0 - 11.0 * n5 / 504.0 - 830251.0 * n6 / 7257600.0;
+    m_beta[4] = 4583.0 * n5 / 161280.0 - 108847.0 * n6 / 3991680.0;
+    m_beta[5] = 20648693.0 * n6 / 638668800.0;
+
+    const double rectifyingRadius = semiMajorAxis / (1.0 + n) * (1.0 + n2 / 4.0 + n4 / 64.0 + n6 / 256.0);
+    m_method = Method::TransverseMercator;
+    m_e = std::sqrt(flattening * (2.0 - flattening));
+    m_lon0 = lon0 * deg2rad;
+    m_scale = k0 * rectifyingRadius;
+    m_falseEasting = x0;
+    m_falseNorthing = y0;
+
+    // rectifying latitude of origin, i.e. the origin's northing on the central meridian
+    const double xi0 = std::atan(conformalTau(std::tan(lat0 * deg2rad)));
+    m_xi0 = xi0;
+    for (std::size_t j = 0; j < Order; ++j) {
+        m_xi0 += m_alpha[j] * std::sin(2.0 * (j + 1) * xi0);
+    }
+}
+
+double GeoProjection::conformalTau(double tau) const
+{
+    const double sigma = std::sinh(m_e * std::atanh(m_e * tau / std::hypot(1.0, tau)));
+    return tau * std::hypot(1.0, sigma) - sigma * std::hypot(1.0, tau);
+}
+
+double GeoProjection::geodeticTau(double conformal) const
+{
+    // Newton iteration, converges within two or three steps
+    const double e2m = 1.0 - m_e * m_e;
+    double tau = conformal / e2m;
+    for (int i = 0; i < 5; ++i) {
+        const double tauPrime = conformalTau(tau);
+        const double delta = (conformal - tauPrime) / std::hypot(1.0, tauPrime) *
+            (1.0 + e2m * tau * tau) / (e2m * std::hypot(1.0, tau));
+        tau += delta;
+        if (std::abs(delta) < 1e-14 * std::max(1.0, std::abs(tau))) {
+            break;
+        }
+    }
+    return tau;
+}
+
+TraCIGeoPosition GeoProjection::convertGeo(const TraCIPosition& pos) const
+{
+    TraCIGeoPosition geo;
+    convertGeo(&pos, &pos + 1, &geo);
+    return geo;
+}
+
+void GeoProjection::convertGeo(const TraCIPosition* first, const TraCIPosition* last, TraCIGeoPosition* out) const
+{
+    if (m_method == Method::Disabled) {
+        throw std::logic_error("conversion by disabled geo projection");
+    }
+
+    for (; first != last; ++first, ++out) {
+        const double x = first->x - m_offsetX;
+        const double y = first->y - m_offsetY;
+        if (m_method == Method::Offset) {
+            out->longitude = x;
+            out->latitude = y;
+            continue;
+        }
+
+        const double xi = (y - m_falseNorthing) / m_scale + m_xi0;
+        const double eta = (x - m_falseEasting) / m_scale;
+        double xiPrime = xi;
+        double etaPrime = eta;
+        for (std::size_t j = 0; j < Order; ++j) {
+            const double k = 2.0 * (j + 1);
+            xiPrime -= m_beta[j] * std::sin(k * xi) * std::cosh(k * eta);
+            etaPrime -= m_beta[j] * std::cos(k * xi) * std::sinh(k * eta);
+        }
+
+        const double sinhEta = std::sinh(etaPrime);
+        const double cosXi = std::cos(xiPrime);
+        const double tauPrime = std::sin(xiPrime) / std::hypot(sinhEta, cosXi);
+        out->latitude = std::atan(geodeticTau(tauPrime)) * rad2deg;
+        out->longitude = (m_lon0 + std::atan2(sinhEta, cosXi)) * rad2deg;
+    }
+}
+
+TraCIPosition GeoProjection::convert2D(const TraCIGeoPosition& geo) const
+{
+    TraCIPosition pos;
+    if (m_method == Method::Disabled) {
+        throw std::logic_error("conversion by disabled geo projection");
+    } else if (m_method == Method::Offset) {
+        pos.x = geo.longitude + m_offsetX;
+        pos.y = geo.latitude + m_offsetY;
+        return pos;
+    }
+
+    const double lambda = geo.longitude * deg2rad - m_lon0;
+    const double tauPrime = conformalTau(std::tan(geo.latitude * deg2rad));
+    const double xiPrime = std::atan2(tauPrime, std::cos(lambda));
+    const double etaPrime = std::asinh(std::sin(lambda) / std::hypot(tauPrime, std::cos(lambda)));
+    double xi = xiPrime;
+    double eta = etaPrime;
+    for (std::size_t j = 0; j < Order; ++j) {
+        const double k = 2.0 * (j + 1);
+        xi += m_alpha[j] * std::sin(k * xiPrime) * std::cosh(k * etaPrime);
+        eta += m_alpha[j] * std::cos(k * xiPrime) * std::sinh(k * etaPrime);
+    }
+
+    pos.x = m_falseEasting + m_scale * eta + m_offsetX;
+    pos.y = m_falseNorthing + m_scale * (xi - m_xi0) + m_offsetY;
+    return pos;
+}
+
+} // namespace traci
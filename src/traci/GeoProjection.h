@@ -0,0 +1,90 @@
+#ifndef GEOPROJECTION_H_K2RVN8QE
+#define GEOPROJECTION_H_K2RVN8QE
+
+#include "traci/GeoPosition.h"
+#include "traci/Position.h"
+#include <array>
+#include <string>
+
+namespace traci
+{
+
+/**
+ * Local replica of SUMO's network projection
+ *
+ * GeoProjection converts between SUMO's Cartesian network coordinates and
+ * WGS84 coordinates without a TraCI round-trip. It is configured by the
+ * "netOffset" and "projParameter" attributes of a SUMO network's location element,
+ * or by the projection parameter and a position converted by TraCI.
+ * Supported are networks without projection ("!") and transverse Mercator
+ * projections ("+proj=utm" or "+proj=tmerc") on WGS84/GRS80 ellipsoids.
+ * Series expansions of Krüger are used, which are accurate to a few nanometres
+ * within the usual extent of a UTM zone.
+ */
+class GeoProjection
+{
+public:
+    /**
+     * Create disabled projection, i.e. a projection not able to convert anything
+     */
+    GeoProjection();
+
+    /**
+     * Create projection matching SUMO's location information
+     *
+     * \param netOffset offset of network coordinates, e.g. "-671732.77,-5908594.20"
+     * \param projParameter SUMO's projection parameter string
+     * \return projection, which is disabled if parameters are not supported
+     */
+    static GeoProjection fromLocation(const std::string& netOffset, const std::string& projParameter);
+
+    /**
+     * Create projection whose net offset is derived from a reference position
+     *
+     * \param projParameter SUMO's projection parameter string
+     * \param pos network position of reference
+     * \param geo geodetic position of reference, e.g. converted by TraCI
+     * \return projection, which is disabled if parameters are not supported
+     */
+    static GeoProjection fromReference(const std::string& projParameter, const TraCIPosition& pos, const TraCIGeoPosition& geo);
+
+    bool isEnabled() const { return m_method != Method::Disabled; }
+
+    TraCIGeoPosition convertGeo(const TraCIPosition&) const;
+    TraCIPosition convert2D(const TraCIGeoPosition&) const;
+
+    /**
+     * Convert a batch of network positions to geodetic positions in one pass
+     *
+     * \param first begin of network positions
+     * \param last end of network positions
+     * \param out begin of output range, needs space for (last - first) elements
+     */
+    void convertGeo(const TraCIPosition* first, const TraCIPosition* last, TraCIGeoPosition* out) const;
+
+private:
+    enum class Method { Disabled, Offset, TransverseMercator };
+    static constexpr std::size_t Order = 6;
+
+    void setupTransverseMercator(double lat0, double lon0, double k0, double x0, double y0);
+    double conformalTau(double tau) const;
+    double geodeticTau(double conformal) const;
+
+    Method m_method;
+    double m_offsetX;
+    double m_offsetY;
+
+    // transverse Mercator parameters (angles in radians)
+    double m_lon0;
+    double m_falseEasting;
+    double m_falseNorthing;
+    double m_scale; /*< k0 * rectifying radius */
+    double m_xi0; /*< rectifying latitude of projection origin */
+    double m_e;
+    std::array<double, Order> m_alpha;
+    std::array<double, Order> m_beta;
+};
+
+} // namespace traci
+
+#endif /* GEOPROJECTION_H_K2RVN8QE */
@@ -34,6 +34,25 @@ VehicleCache::VehicleCache(std::shared_ptr<API> api, const std::string& vehicleI
 {
 }
 
+void VehicleCache::reset(const libsumo::TraCIResults& values)
+{
+    VariableCache::reset(values);
+    m_geo_valid = false;
+}
+
+const TraCIGeoPosition* VehicleCache::getGeoPosition() const
+{
+    m_geo_requested = true;
+    return m_geo_valid ? &m_geo : nullptr;
+}
+
+void VehicleCache::setGeoPosition(const TraCIGeoPosition& geo)
+{
+    m_geo = geo;
+    m_geo_valid = true;
+    m_geo_requested = false;
+}
+
 template<>
 double VariableCache::retrieve<double>(int var)
 {
@@ -64,7 +64,9 @@ public:
      * Reset cache, i.e all previously stored values are dropped
      * \param values new values to be stored
      */
-    void reset(const libsumo::TraCIResults& values);
+    virtual void reset(const libsumo::TraCIResults& values);
+
+    virtual ~VariableCache() = default;
 
 protected:
     VariableCache(std::shared_ptr<API> api, int command, const std::string& id);
@@ -90,6 +92,27 @@ class VehicleCache : public VariableCache
 public:
     VehicleCache(std::shared_ptr<API> api, const std::string& vehicleID);
     const std::string& getVehicleId() const { return getId(); }
+
+    void reset(const libsumo::TraCIResults& values) override;
+
+    /**
+     * Geodetic position projected from current position
+     *
+     * Each call marks the geodetic position as requested, i.e. it gets projected along with the next batch.
+     * \return nullptr if not projected since last reset
+     */
+    const TraCIGeoPosition* getGeoPosition() const;
+    void setGeoPosition(const TraCIGeoPosition&);
+
+    /**
+     * Check if geodetic position has been requested since it has been projected last
+     */
+    bool isGeoPositionRequested() const { return m_geo_requested; }
+
+private:
+    TraCIGeoPosition m_geo;
+    bool m_geo_valid = false;
+    mutable bool m_geo_requested = false;
 };
 
 class SimulationCache : public VariableCache
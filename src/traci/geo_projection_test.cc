@@ -0,0 +1,125 @@
+/*
+ * Accuracy test of traci::GeoProjection
+ *
+ * Reference points have been projected by PROJ 9.5 using the
+ * projection parameters found in SUMO networks of Artery's scenarios.
+ */
+
+#include "traci/GeoProjection.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+struct ReferencePoint
+{
+    double longitude;
+    double latitude;
+    double x;
+    double y;
+};
+
+struct Reference
+{
+    std::string projParameter;
+    std::vector<ReferencePoint> points;
+};
+
+const std::vector<Reference> references = {
+    { "+proj=utm +zone=32 +ellps=WGS84 +datum=WGS84 +units=m +no_defs", {
+        { 11.0068, 49.5897, 645037.054307, 5494947.658069 },
+        { 9.0, 0.5, 500000.000000, 55265.037143 },
+        { 11.9, 55.0, 685481.678628, 6098637.915555 },
+        { 6.2, 47.3, 288329.510950, 5242305.401003 },
+    } },
+    { "+proj=utm +zone=29 +ellps=WGS84 +datum=WGS84 +units=m +no_defs", {
+        { -6.3, 53.35, 679710.218550, 5914604.557698 },
+        { -8.9, 51.9, 506880.339993, 5749920.747886 },
+    } },
+    { "+proj=utm +zone=22 +south +ellps=WGS84 +units=m +no_defs", {
+        { -51.2, -30.0, 480710.443117, 6681197.814062 },
+        { -48.1, -1.5, 822726.115969, 9833990.615911 },
+    } },
+    { "+proj=tmerc +lat_0=48.78407 +lon_0=11.47258 +ellps=WGS84 +datum=WGS84 +units=m +no_defs", {
+        { 11.43, 48.76, -3130.597146, -2675.837302 },
+        { 11.52, 48.8, 3483.677899, 1772.591597 },
+        { 11.47258, 48.9, 0.000000, 12892.189988 },
+    } },
+    { "+proj=tmerc +lat_0=51 +lon_0=-2 +ellps=WGS84 +datum=WGS84 +units=m +no_defs", {
+        { -1.5, 51.2, 34947.634035, 22368.879072 },
+        { -2.7, 50.6, -49559.428451, -44263.833794 },
+    } },
+};
+
+const double toleranceMetres = 1e-4;
+const double toleranceDegrees = 1e-9;
+
+// arbitrary net offset as applied by netconvert
+const double offsetX = -640548.92;
+const double offsetY = -5493434.20;
+
+} // namespace
+
+int main()
+{
+    using namespace traci;
+    unsigned failures = 0;
+    auto check = [&failures](bool passed, const std::string& what, double deviation) {
+        if (!passed) {
+            std::cerr << what << " deviates by " << deviation << std::endl;
+            ++failures;
+        }
+    };
+
+    for (const Reference& reference : references) {
+        std::ostringstream netOffset;
+        netOffset.precision(17);
+        netOffset << offsetX << "," << offsetY;
+        const GeoProjection projection = GeoProjection::fromLocation(netOffset.str(), reference.projParameter);
+        if (!projection.isEnabled()) {
+            std::cerr << "projection \"" << reference.projParameter << "\" is not supported" << std::endl;
+            ++failures;
+            continue;
+        }
+
+        for (const ReferencePoint& point : reference.points) {
+            const std::string label = reference.projParameter + " at " +
+                std::to_string(point.longitude) + "," + std::to_string(point.latitude);
+
+            TraCIGeoPosition geo;
+            geo.longitude = point.longitude;
+            geo.latitude = point.latitude;
+            const TraCIPosition pos = projection.convert2D(geo);
+            const double distance = std::hypot(pos.x - offsetX - point.x, pos.y - offsetY - point.y);
+            check(distance < toleranceMetres, "forward projection of " + label, distance);
+
+            TraCIPosition net;
+            net.x = point.x + offsetX;
+            net.y = point.y + offsetY;
+            const TraCIGeoPosition inverse = projection.convertGeo(net);
+            const double angle = std::max(std::abs(inverse.longitude - point.longitude),
+                std::abs(inverse.latitude - point.latitude));
+            check(angle < toleranceDegrees, "inverse projection of " + label, angle);
+
+            // net offset derived from a single reference as done at traci.init
+            const GeoProjection derived = GeoProjection::fromReference(reference.projParameter, net, geo);
+            TraCIPosition shifted;
+            shifted.x = net.x + 1000.0;
+            shifted.y = net.y - 500.0;
+            const TraCIPosition rederived = derived.convert2D(projection.convertGeo(shifted));
+            const double shift = std::hypot(rederived.x - net.x - 1000.0, rederived.y - net.y + 500.0);
+            check(shift < toleranceMetres, "derived net offset of " + label, shift);
+        }
+    }
+
+    if (failures > 0) {
+        std::cerr << failures << " checks failed" << std::endl;
+        return 1;
+    }
+    return 0;
+}